@@ -47,13 +47,8 @@ struct nlohmann::adl_serializer<T, describe::if_described_enum_t<T>>
                 }
             });
         } else {
-            auto str = j.template get<std::string>();
-            describe::Get<T>::for_each([&](auto info){
-                if (!hit && str == info.name) {
-                    val = info.value;
-                    hit = true;
-                }
-            });
+            // respects describe::case_insensitive
+            hit = describe::name_to_enum(j.template get<std::string>(), val);
         }
         if (!hit) {
             throw std::runtime_error(
@@ -165,12 +160,12 @@ enum ObjectType {
     Ugly,
 };
 
-DESCRIBE("ObjectType", ObjectType) {
+DESCRIBE("ObjectType", ObjectType, describe::case_insensitive) {
     MEMBER("good", Good);
     MEMBER("bad", Bad);
     MEMBER("ugly", Ugly); // serialized into this if == ObjectType::Ugly
-    MEMBER("UGLY", Ugly); // "for backwards-compat" (can be deserialized from this string)
-    // You can make a custom attribute for case-insensitive deserialize (like with AsInteger)
+    MEMBER("nasty", Ugly); // "for backwards-compat" (can be deserialized from this string)
+    // describe::case_insensitive: "UGLY" and "Nasty" are accepted too
 }
 
 enum SizeHint {
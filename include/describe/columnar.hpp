@@ -0,0 +1,415 @@
+/*
+columnar.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_COLUMNAR_HPP
+#define DESCRIBE_COLUMNAR_HPP
+#include "describe.hpp"
+#include "flat.hpp"
+#include "shape.hpp"
+#include "span.hpp"
+#include "traits.hpp"
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <string.h>
+
+namespace describe
+{
+
+// Physical layout of a column (Arrow-like):
+// * boolean, signed_int, unsigned_int, floating -> `data` holds `width` bytes per row
+// * string -> `offsets` holds rows + 1 offsets into `data` (64-bit, like Arrow large_string:
+//   a batch of millions of records easily passes 2 GiB of text)
+// * dictionary -> `data` holds int32_t indices into `dictionary` (described enums)
+enum class column_kind : uint8_t {
+    boolean,
+    signed_int,
+    unsigned_int,
+    floating,
+    string,
+    dictionary,
+};
+
+struct column {
+    std::string_view name;
+    column_kind kind = column_kind::boolean;
+    uint8_t width = 0;
+    bool nullable = false; // only nullable columns keep `validity`
+    size_t null_count = 0;
+    std::vector<uint8_t> validity; // bit per row (LSB first), 1 -> value present
+    std::vector<int64_t> offsets;
+    std::vector<char> data;
+    span<const std::string_view> dictionary;
+
+    bool valid(size_t row) const noexcept {
+        return !nullable || (validity[row >> 3] >> (row & 7)) & 1;
+    }
+    template<typename V>
+    const V* values() const noexcept {
+        return reinterpret_cast<const V*>(data.data());
+    }
+    std::string_view string_at(size_t row) const noexcept {
+        return {data.data() + offsets[row], size_t(offsets[row + 1] - offsets[row])};
+    }
+};
+
+namespace detail {
+
+// Distinct values of described enum (first name wins, like enum_to_name())
+template<typename E>
+struct enum_dictionary {
+    static constexpr auto all_names = enum_names<E>();
+    static constexpr auto all_values = enum_values<E>();
+
+    static constexpr size_t count_unique() {
+        size_t res = 0;
+        for (size_t i = 0; i < all_values.size(); ++i) {
+            bool seen = false;
+            for (size_t j = 0; j < i; ++j) seen = seen || all_values[j] == all_values[i];
+            if (!seen) res++;
+        }
+        return res;
+    }
+
+    static constexpr size_t size = count_unique();
+
+    template<typename Out, typename In>
+    static constexpr auto pick_unique(const In& from) {
+        std::array<Out, size> res{};
+        size_t idx = 0;
+        for (size_t i = 0; i < all_values.size(); ++i) {
+            bool seen = false;
+            for (size_t j = 0; j < i; ++j) seen = seen || all_values[j] == all_values[i];
+            if (!seen) res[idx++] = from[i];
+        }
+        return res;
+    }
+
+    static constexpr auto names = pick_unique<std::string_view>(all_names);
+    static constexpr auto values = pick_unique<E>(all_values);
+
+    static constexpr int32_t index(E value) noexcept {
+        for (size_t i = 0; i < size; ++i) {
+            if (values[i] == value) return int32_t(i);
+        }
+        return -1;
+    }
+};
+
+template<typename F>
+struct column_type {
+    using value_type = typename unwrap_optional<F>::type;
+    static constexpr bool nullable = unwrap_optional<F>::value;
+    static constexpr bool is_string =
+        std::is_same_v<value_type, std::string> || std::is_same_v<value_type, std::string_view>;
+    static constexpr bool is_dictionary = is_described_enum_v<value_type>;
+    using numeric = typename std::conditional_t<
+        std::is_enum_v<value_type> && !is_dictionary,
+        std::underlying_type<value_type>,
+        Tag<value_type>>::type;
+    static constexpr bool supported = is_string || is_dictionary || std::is_arithmetic_v<numeric>;
+
+    static constexpr column_kind kind() {
+        if constexpr (is_string) return column_kind::string;
+        else if constexpr (is_dictionary) return column_kind::dictionary;
+        else if constexpr (std::is_same_v<numeric, bool>) return column_kind::boolean;
+        else if constexpr (std::is_floating_point_v<numeric>) return column_kind::floating;
+        else if constexpr (std::is_signed_v<numeric>) return column_kind::signed_int;
+        else return column_kind::unsigned_int;
+    }
+    static constexpr uint8_t width() {
+        if constexpr (is_string) return 0;
+        else if constexpr (is_dictionary) return sizeof(int32_t);
+        else return sizeof(numeric);
+    }
+};
+
+inline void set_validity(column& col, size_t row, bool present) {
+    if (present) {
+        col.validity[row >> 3] |= uint8_t(1u << (row & 7));
+    } else {
+        col.null_count++;
+    }
+}
+
+template<typename F, typename T, typename Member>
+void append_column(column& col, size_t first_row, span<const T> batch, Member f) {
+    using traits = column_type<F>;
+    const size_t count = batch.size();
+    if constexpr (traits::nullable || traits::is_dictionary) {
+        col.validity.resize((first_row + count + 7) / 8, 0);
+    }
+    auto present = [&](const F& field) -> bool {
+        if constexpr (traits::nullable) return field.has_value();
+        else return true;
+    };
+    auto value = [&](const F& field) -> const typename traits::value_type& {
+        if constexpr (traits::nullable) return *field;
+        else return field;
+    };
+    if constexpr (traits::is_string) {
+        if (col.offsets.empty()) col.offsets.push_back(0);
+        col.offsets.reserve(col.offsets.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            const F& field = f.get(batch[i]);
+            bool ok = present(field);
+            if constexpr (traits::nullable) set_validity(col, first_row + i, ok);
+            if (ok) {
+                std::string_view str = value(field);
+                col.data.insert(col.data.end(), str.begin(), str.end());
+            }
+            col.offsets.push_back(int64_t(col.data.size()));
+        }
+    } else {
+        const size_t width = traits::width();
+        const size_t old = col.data.size();
+        col.data.resize(old + count * width);
+        char* out = col.data.data() + old;
+        for (size_t i = 0; i < count; ++i, out += width) {
+            const F& field = f.get(batch[i]);
+            bool ok = present(field);
+            if constexpr (traits::is_dictionary) {
+                int32_t idx = ok ? enum_dictionary<typename traits::value_type>::index(value(field)) : -1;
+                set_validity(col, first_row + i, idx >= 0);
+                memcpy(out, &idx, width);
+            } else {
+                typename traits::numeric num{};
+                if (ok) num = static_cast<typename traits::numeric>(value(field));
+                if constexpr (traits::nullable) set_validity(col, first_row + i, ok);
+                memcpy(out, &num, width);
+            }
+        }
+    }
+}
+
+inline void csv_escaped(std::string& out, std::string_view str) {
+    if (str.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out += str;
+        return;
+    }
+    out += '"';
+    for (char c: str) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+template<typename V>
+void csv_number(std::string& out, V value) {
+    char buff[64];
+    auto res = std::to_chars(buff, buff + sizeof(buff), value);
+    out.append(buff, res.ptr);
+}
+
+template<typename V>
+void csv_cell(std::string& out, const V& value) {
+    if constexpr (unwrap_optional<V>::value) {
+        if (value) csv_cell(out, *value);
+    } else if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view>) {
+        csv_escaped(out, value);
+    } else if constexpr (std::is_same_v<V, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_enum_v<V>) {
+        std::string_view name;
+        if constexpr (is_described_enum_v<V>) {
+            if (enum_to_name(value, name)) return csv_escaped(out, name);
+        }
+        csv_cell(out, std::underlying_type_t<V>(value));
+    } else {
+        static_assert(std::is_arithmetic_v<V>, "write_csv(): unsupported field type");
+        csv_number(out, value);
+    }
+}
+
+// Erased csv_cell(): same output, one switch instead of a template per field type
+inline void csv_cell(std::string& out, const shape_field& field, const unsigned char* obj) {
+    const unsigned char* at = obj + field.offset;
+    switch (field.kind) {
+    case shape_kind::boolean: {
+        bool value;
+        memcpy(&value, at, sizeof(bool));
+        out += value ? "true" : "false";
+        break;
+    }
+    case shape_kind::signed_int:
+        csv_number(out, int64_t(shape_read_int(at, field.size, true)));
+        break;
+    case shape_kind::unsigned_int:
+        csv_number(out, shape_read_int(at, field.size, false));
+        break;
+    case shape_kind::floating:
+        if (field.size == sizeof(float)) {
+            float value;
+            memcpy(&value, at, sizeof(float));
+            csv_number(out, value);
+        } else {
+            double value;
+            memcpy(&value, at, sizeof(double));
+            csv_number(out, value);
+        }
+        break;
+    case shape_kind::string:
+        csv_escaped(out, *reinterpret_cast<const std::string*>(at));
+        break;
+    case shape_kind::string_view:
+        csv_escaped(out, *reinterpret_cast<const std::string_view*>(at));
+        break;
+    case shape_kind::enumeration: {
+        auto& table = *field.enumeration;
+        uint64_t value = shape_read_int(at, field.size, table.is_signed);
+        std::string_view name;
+        if (shape_enum_name(table, value, name)) csv_escaped(out, name);
+        else if (table.is_signed) csv_number(out, int64_t(value));
+        else csv_number(out, value);
+        break;
+    }
+    case shape_kind::nested: // rejected by write_csv_erased()
+        break;
+    }
+}
+
+} //detail
+
+// Transposes described records into per-field contiguous buffers (see column_kind)
+template<typename T>
+class columnar_writer {
+    static_assert(is_described_struct_v<T>, "columnar_writer<T>: T must be described");
+public:
+    static constexpr size_t columns_count = flat_fields_count<T>();
+
+    columnar_writer() {
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                using traits = detail::column_type<decltype(of(f))>;
+                static_assert(traits::supported, "columnar_writer<T>: unsupported field type");
+                auto& col = _columns[idx++];
+                col.name = f.name;
+                col.kind = traits::kind();
+                col.width = traits::width();
+                col.nullable = traits::nullable || traits::is_dictionary;
+                if constexpr (traits::is_dictionary) {
+                    col.dictionary = detail::enum_dictionary<typename traits::value_type>::names;
+                }
+            }
+        });
+    }
+
+    void append(span<const T> batch) {
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                detail::append_column<decltype(of(f))>(_columns[idx++], _rows, batch, f);
+            }
+        });
+        _rows += batch.size();
+    }
+
+    void append(const T& record) {
+        append(span<const T>{&record, 1});
+    }
+
+    void clear() {
+        for (auto& col: _columns) {
+            col.null_count = 0;
+            col.validity.clear();
+            col.offsets.clear();
+            col.data.clear();
+        }
+        _rows = 0;
+    }
+
+    size_t rows() const noexcept {return _rows;}
+    const std::array<column, columns_count>& columns() const noexcept {return _columns;}
+    const column& operator[](size_t idx) const noexcept {return _columns[idx];}
+private:
+    std::array<column, columns_count> _columns;
+    size_t _rows = 0;
+};
+
+// write_csv() over a shape_of<T>() table: a single non-template loop shared by all types.
+// `rows` points to `count` objects of `table.size` bytes. Nested fields are not supported:
+// returns false (and writes nothing) if `table` has any
+inline bool write_csv_erased(const shape& table, const void* rows, size_t count, std::string& out, bool header = true) {
+    for (auto& field: table.fields) {
+        if (field.kind == shape_kind::nested) return false;
+    }
+    if (header) {
+        bool first = true;
+        for (auto& field: table.fields) {
+            if (!first) out += ',';
+            first = false;
+            detail::csv_escaped(out, field.name);
+        }
+        out += '\n';
+    }
+    auto row = static_cast<const unsigned char*>(rows);
+    for (size_t i = 0; i < count; ++i, row += table.size) {
+        bool first = true;
+        for (auto& field: table.fields) {
+            if (!first) out += ',';
+            first = false;
+            detail::csv_cell(out, field, row);
+        }
+        out += '\n';
+    }
+    return true;
+}
+
+template<typename T, if_described_struct_t<T, int> = 1>
+void write_csv_erased(span<const T> rows, std::string& out, bool header = true) {
+    static_assert(detail::shape_flat<T>(), "write_csv_erased(): fields must be flat and have a shape_kind");
+    write_csv_erased(shape_of<T>(), rows.data(), rows.size(), out, header);
+}
+
+// write_csv() with a for_each() chain instantiated for T
+template<typename T, if_described_struct_t<T, int> = 1>
+void write_csv_typed(span<const T> rows, std::string& out, bool header = true) {
+    if (header) {
+        bool first = true;
+        for (auto name: flat_field_names<T>()) {
+            if (!first) out += ',';
+            first = false;
+            detail::csv_escaped(out, name);
+        }
+        out += '\n';
+    }
+    for (auto& row: rows) {
+        bool first = true;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                if (!first) out += ',';
+                first = false;
+                detail::csv_cell(out, f.get(row));
+            }
+        });
+        out += '\n';
+    }
+}
+
+// Appends rows as CSV (RFC 4180 quoting), header is taken from flat_field_names<T>().
+// With DESCRIBE_SHAPE_ERASED goes through write_csv_erased() when T allows it
+template<typename T, if_described_struct_t<T, int> = 1>
+void write_csv(span<const T> rows, std::string& out, bool header = true) {
+#ifdef DESCRIBE_SHAPE_ERASED
+    constexpr bool erased = detail::shape_flat<T>();
+#else
+    constexpr bool erased = false;
+#endif
+    if constexpr (erased) {
+        write_csv_erased(rows, out, header);
+    } else {
+        write_csv_typed(rows, out, header);
+    }
+}
+
+} //describe
+
+#endif //DESCRIBE_COLUMNAR_HPP
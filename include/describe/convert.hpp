@@ -0,0 +1,231 @@
+/*
+convert.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_CONVERT_HPP
+#define DESCRIBE_CONVERT_HPP
+#include "describe.hpp"
+#include "traits.hpp"
+#include <string.h>
+
+namespace describe
+{
+
+template<typename To, typename From>
+void convert(const From& from, To& to);
+
+namespace detail {
+
+template<typename F, typename T>
+constexpr bool field_convertible() {
+    if constexpr (std::is_same_v<F, T>) return true;
+    else if constexpr (is_described_struct_v<F> && is_described_struct_v<T>) return true;
+    else if constexpr (is_described_enum_v<F> && is_described_enum_v<T>) return true;
+    else return std::is_convertible_v<const F&, T>;
+}
+
+template<typename F, typename T>
+void convert_field(const F& from, T& to) {
+    if constexpr (std::is_same_v<F, T>) {
+        to = from;
+    } else if constexpr (is_described_struct_v<F> && is_described_struct_v<T>) {
+        convert(from, to);
+    } else if constexpr (is_described_enum_v<F> && is_described_enum_v<T>) {
+        // by described name, unknown values leave `to` untouched
+        std::string_view name;
+        if (enum_to_name(from, name)) (void)name_to_enum(name, to);
+    } else {
+        to = static_cast<T>(from);
+    }
+}
+
+struct copy_run {
+    size_t from;
+    size_t to;
+    size_t size;
+};
+
+template<typename To, typename From>
+struct convert_plan {
+    static constexpr size_t npos = size_t(-1);
+    static constexpr size_t to_count = fields_count<To>();
+
+    // To field -> index of From field with the same name
+    static constexpr auto make_match() {
+        std::array<size_t, to_count> res{};
+        constexpr auto to_names = field_names<To>();
+        constexpr auto from_names = field_names<From>();
+        for (size_t j = 0; j < to_count; ++j) {
+            res[j] = npos;
+            for (size_t i = 0; i < from_names.size() && res[j] == npos; ++i) {
+                if (to_names[j] == from_names[i]) res[j] = i;
+            }
+        }
+        return res;
+    }
+
+    static constexpr auto match = make_match();
+
+    // Field index -> type_key<Member>()
+    template<typename T>
+    static constexpr auto make_keys() {
+        std::array<std::string_view, fields_count<T>()> res{};
+        size_t idx = 0;
+        Get<T>::for_each([&](auto f){
+            if constexpr (f.is_field) res[idx++] = type_key<decltype(f)>();
+        });
+        return res;
+    }
+
+    static constexpr auto to_keys = make_keys<To>();
+    static constexpr auto from_keys = make_keys<From>();
+
+    // Some field of To described by TM is matched to a field of From described by FM
+    // (FM = void: to any field)
+    template<typename TM, typename FM>
+    static constexpr bool matched() {
+        for (size_t j = 0; j < to_count; ++j) {
+            if (match[j] == npos || to_keys[j] != type_key<TM>()) continue;
+            if (std::is_void_v<FM> || from_keys[match[j]] == type_key<FM>()) return true;
+        }
+        return false;
+    }
+
+    // Calls fn(to_member, from_member) for every matched pair. Pairs are filtered at compile time
+    // (fn is instantiated only for matched Member types), then by index: several MEMBER()s
+    // over the same pointer share a Member type, but not an index
+    template<typename Fn>
+    static constexpr void for_each_pair(Fn&& fn) {
+        size_t j = 0;
+        Get<To>::for_each([&](auto t){
+            if constexpr (t.is_field) {
+                using TM = decltype(t);
+                const size_t want = match[j++];
+                if constexpr (matched<TM, void>()) {
+                    size_t i = 0;
+                    Get<From>::for_each([&](auto f){
+                        if constexpr (f.is_field) {
+                            if constexpr (matched<TM, decltype(f)>()) {
+                                if (i == want) fn(t, f);
+                            }
+                            i++;
+                        }
+                    });
+                }
+            }
+        });
+    }
+
+    static constexpr bool all_convertible() {
+        bool ok = true;
+        for_each_pair([&](auto t, auto f){
+            ok = ok && field_convertible<decltype(of(f)), decltype(of(t))>();
+        });
+        return ok;
+    }
+
+    // Same trivially copyable type at a static offset (not in a virtual base) -> may be memcpy-ed
+    template<typename TM, typename FM>
+    static constexpr bool copyable() {
+        using T = typename TM::type;
+        return std::is_same_v<T, typename FM::type>
+            && std::is_trivially_copyable_v<T>
+            && !via_virtual_base<To, typename TM::cls>
+            && !via_virtual_base<From, typename FM::cls>;
+    }
+
+    static constexpr size_t copyable_count() {
+        size_t res = 0;
+        for_each_pair([&](auto t, auto f){
+            res += copyable<decltype(t), decltype(f)>();
+        });
+        return res;
+    }
+
+    static constexpr size_t max_runs = copyable_count();
+
+    struct runs_t {
+        std::array<copy_run, max_runs> data{};
+        size_t count = 0;
+    };
+
+    // Adjacent (in both layouts) copyable fields are merged into a single memcpy
+    static runs_t make_runs() {
+        runs_t res;
+        for_each_pair([&](auto t, auto f){
+            if constexpr (copyable<decltype(t), decltype(f)>()) {
+                res.data[res.count++] = {
+                    offset_of<From>(f.value),
+                    offset_of<To>(t.value),
+                    sizeof(typename decltype(t)::type)
+                };
+            }
+        });
+        for (size_t i = 1; i < res.count; ++i) {
+            for (size_t k = i; k > 0 && res.data[k].to < res.data[k - 1].to; --k) {
+                std::swap(res.data[k], res.data[k - 1]);
+            }
+        }
+        size_t merged = 0;
+        for (size_t i = 0; i < res.count; ++i) {
+            auto& last = res.data[merged ? merged - 1 : 0];
+            auto& cur = res.data[i];
+            if (merged && last.from + last.size == cur.from && last.to + last.size == cur.to) {
+                last.size += cur.size;
+            } else {
+                res.data[merged++] = cur;
+            }
+        }
+        res.count = merged;
+        return res;
+    }
+
+    static const runs_t& runs() {
+        static const runs_t result = make_runs();
+        return result;
+    }
+};
+
+} //detail
+
+// Assigns fields of `to` from fields of `from` with the same described name.
+// Nested described structs are converted recursively, described enums - by name.
+// Matching trivially copyable fields are copied with as few memcpy() calls as layouts allow
+template<typename To, typename From>
+void convert(const From& from, To& to) {
+    static_assert(is_described_struct_v<To> && is_described_struct_v<From>, "convert(): both types must be described");
+    using plan = detail::convert_plan<To, From>;
+    static_assert(plan::all_convertible(), "convert(): field with the same name has inconvertible type");
+    if constexpr (plan::max_runs > 0) {
+        auto& runs = plan::runs();
+        auto src = reinterpret_cast<const unsigned char*>(&from);
+        auto dst = reinterpret_cast<unsigned char*>(&to);
+        for (size_t i = 0; i < runs.count; ++i) {
+            memcpy(dst + runs.data[i].to, src + runs.data[i].from, runs.data[i].size);
+        }
+    }
+    plan::for_each_pair([&](auto t, auto f){
+        using T = decltype(of(t));
+        using F = decltype(of(f));
+        if constexpr (!plan::template copyable<decltype(t), decltype(f)>()) {
+            if constexpr (detail::field_convertible<F, T>()) {
+                detail::convert_field(f.get(from), t.get(to));
+            }
+        }
+    });
+}
+
+template<typename To, typename From>
+To convert(const From& from) {
+    To res{};
+    convert(from, res);
+    return res;
+}
+
+} //describe
+
+#endif //DESCRIBE_CONVERT_HPP
@@ -31,6 +31,9 @@ SOFTWARE.
 #include <type_traits>
 #include <utility>
 #include <array>
+#ifdef DESCRIBE_PROFILE
+#include <atomic>
+#endif
 namespace describe
 {
 
@@ -61,6 +64,10 @@ struct info<T, std::enable_if_t<std::is_member_pointer_v<T>>> {
     using type = typename decltype(detail::get_memptr_type(T{}))::type;
 };
 
+#ifdef DESCRIBE_PROFILE
+template<typename Mem, typename T> constexpr void count_access() noexcept;
+#endif
+
 } //detail
 
 template<auto field, typename...Attrs>
@@ -77,6 +84,9 @@ struct Member {
     using Attributes = TypeList<Attrs...>;
     template<typename T> static constexpr decltype(auto) get(T&& obj) noexcept {
         static_assert(is_field);
+#ifdef DESCRIBE_PROFILE
+        detail::count_access<Member, T>();
+#endif
         return std::forward<T>(obj).*field;
     }
     template<typename Object, typename...Args> static constexpr decltype(auto) call(Object&& object, Args&&...args) noexcept {
@@ -251,6 +261,16 @@ constexpr auto enum_names() {
     return result;
 }
 
+template<typename T, if_described_enum_t<T, int> = 1>
+constexpr auto enum_values() {
+    std::array<T, enums_count<T>()> result{};
+    size_t idx = 0;
+    Get<T>::for_each([&](auto f){
+        if constexpr (f.is_enum) result[idx++] = f.value;
+    });
+    return result;
+}
+
 template<typename T, if_described_struct_t<T, int> = 1>
 constexpr size_t methods_count() {
     size_t res = 0;
@@ -285,19 +305,225 @@ constexpr bool enum_to_name(Enum value, std::string_view& out) {
     return found;
 }
 
+// Enum attribute: name_to_enum() ignores case ("READ" == "read")
+struct case_insensitive {};
+// Enum attribute: also ignores '_', '-', '.' and ' ' ("read_write" == "ReadWrite")
+struct separator_insensitive : case_insensitive {};
+
+namespace detail {
+
+constexpr bool is_name_separator(char c) noexcept {
+    return c == '_' || c == '-' || c == '.' || c == ' ';
+}
+
+constexpr char to_lower(char c) noexcept {
+    return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+
+constexpr uint32_t fnv1a(uint32_t hash, char c) noexcept {
+    return (hash ^ uint8_t(c)) * 16777619u;
+}
+
+// Normalized names and their open-addressing hash table are built at compile time.
+// Exact table (no normalization) is used for tokens of flags enums
+template<typename Enum, bool exact = !has_v<case_insensitive, Enum>>
+struct hashed_enum_names {
+    static constexpr bool fold_case = !exact;
+    static constexpr bool skip_separators = !exact && has_v<separator_insensitive, Enum>;
+    static constexpr auto names = enum_names<Enum>();
+    static constexpr auto values = enum_values<Enum>();
+    static constexpr size_t count = names.size();
+
+    static constexpr size_t max_length() {
+        size_t res = 0;
+        for (auto name: names) res = name.size() > res ? name.size() : res;
+        return res;
+    }
+
+    static constexpr size_t max_len = max_length();
+
+    static constexpr size_t buckets_count() {
+        size_t res = 1;
+        while (res < count * 2) res *= 2;
+        return res;
+    }
+
+    static constexpr size_t buckets = buckets_count();
+
+    // Normalizes and hashes input char by char. `fits` is false if too long to match anything
+    struct folded {
+        char name[max_len + 1] = {};
+        size_t len = 0;
+        uint32_t hash = 2166136261u;
+        bool fits = true;
+
+        constexpr void push(char c) noexcept {
+            if (skip_separators && is_name_separator(c)) return;
+            if (len == max_len) {
+                fits = false;
+                return;
+            }
+            if (fold_case) c = to_lower(c);
+            name[len++] = c;
+            hash = fnv1a(hash, c);
+        }
+    };
+
+    static constexpr folded fold(std::string_view name) noexcept {
+        folded res{};
+        for (char c: name) res.push(c);
+        return res;
+    }
+
+    static constexpr bool same(const folded& a, const folded& b) noexcept {
+        if (a.hash != b.hash || a.len != b.len) return false;
+        for (size_t i = 0; i < a.len; ++i) {
+            if (a.name[i] != b.name[i]) return false;
+        }
+        return true;
+    }
+
+    static constexpr auto make_folded() {
+        std::array<folded, count> res{};
+        for (size_t i = 0; i < count; ++i) res[i] = fold(names[i]);
+        return res;
+    }
+
+    static constexpr auto entries = make_folded();
+
+    // slot -> index into names + 1 (0 is empty). Aliases folding into same name: first wins
+    static constexpr auto make_slots() {
+        std::array<size_t, buckets> res{};
+        for (size_t i = 0; i < count; ++i) {
+            size_t slot = entries[i].hash & (buckets - 1);
+            bool dup = false;
+            while (res[slot] && !dup) {
+                dup = same(entries[res[slot] - 1], entries[i]);
+                slot = (slot + 1) & (buckets - 1);
+            }
+            if (!dup) res[slot] = i + 1;
+        }
+        return res;
+    }
+
+    static constexpr auto slots = make_slots();
+
+    static constexpr bool find(const folded& input, Enum& out) noexcept {
+        if (!input.fits) return false;
+        for (size_t slot = input.hash & (buckets - 1); slots[slot]; slot = (slot + 1) & (buckets - 1)) {
+            if (same(entries[slots[slot] - 1], input)) {
+                out = values[slots[slot] - 1];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static constexpr bool find(std::string_view name, Enum& out) noexcept {
+        return find(fold(name), out);
+    }
+};
+
+} //detail
+
 template<typename Enum, if_described_enum_t<Enum, int> = 1>
 [[nodiscard]]
 constexpr bool name_to_enum(std::string_view name, Enum& out) {
-    bool found = false;
-    Get<Enum>::for_each([&](auto f){
-        if constexpr (f.is_enum) {
-            if (!found && f.name == name) {
-                out = f.value;
-                found = true;
+    if constexpr (has_v<case_insensitive, Enum>) {
+        return detail::hashed_enum_names<Enum>::find(name, out);
+    } else {
+        bool found = false;
+        Get<Enum>::for_each([&](auto f){
+            if constexpr (f.is_enum) {
+                if (!found && f.name == name) {
+                    out = f.value;
+                    found = true;
+                }
             }
+        });
+        return found;
+    }
+}
+
+// Profiling: attribute for structs or members. When DESCRIBE_PROFILE is defined
+// every Member::get() of a profiled field bumps a relaxed atomic counter (see profile_report()).
+// Otherwise it has no effect at all
+struct profiled {};
+
+struct field_profile {
+    std::string_view name;
+    // Member::get() on a const / non-const object. Tells nothing about what the caller does
+    // with the result: e.g. reading a field of a non-const object counts as mutable access
+    uint64_t const_accesses = 0;
+    uint64_t mutable_accesses = 0;
+};
+
+#ifdef DESCRIBE_PROFILE
+namespace detail {
+
+struct alignas(64) access_counter {
+    std::atomic<uint64_t> const_accesses{0};
+    std::atomic<uint64_t> mutable_accesses{0};
+};
+
+template<auto field>
+inline access_counter field_counter;
+
+template<typename Mem, typename T>
+constexpr void count_access() noexcept {
+    using cls = typename Mem::cls;
+    constexpr bool enabled = has_v<profiled, Mem> || [] {
+        if constexpr (is_described_v<cls>) return has_v<profiled, cls>;
+        else return false;
+    }();
+    if constexpr (enabled) {
+#if __cplusplus >= 202002L
+        if (std::is_constant_evaluated()) return;
+#else
+        if (__builtin_is_constant_evaluated()) return;
+#endif
+        auto& counter = field_counter<Mem::value>;
+        if constexpr (std::is_const_v<std::remove_reference_t<T>>) {
+            counter.const_accesses.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            counter.mutable_accesses.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} //detail
+#endif //DESCRIBE_PROFILE
+
+// Access counts of each field of T (all zeroes if DESCRIBE_PROFILE is not defined)
+template<typename T, if_described_struct_t<T, int> = 1>
+auto profile_report() {
+    std::array<field_profile, fields_count<T>()> result;
+    size_t idx = 0;
+    Get<T>::for_each([&](auto f){
+        if constexpr (f.is_field) {
+            auto& out = result[idx++];
+            out.name = f.name;
+#ifdef DESCRIBE_PROFILE
+            auto& counter = detail::field_counter<f.value>;
+            out.const_accesses = counter.const_accesses.load(std::memory_order_relaxed);
+            out.mutable_accesses = counter.mutable_accesses.load(std::memory_order_relaxed);
+#endif
         }
     });
-    return found;
+    return result;
+}
+
+template<typename T, if_described_struct_t<T, int> = 1>
+void profile_reset() {
+#ifdef DESCRIBE_PROFILE
+    Get<T>::for_each([&](auto f){
+        if constexpr (f.is_field) {
+            auto& counter = detail::field_counter<f.value>;
+            counter.const_accesses.store(0, std::memory_order_relaxed);
+            counter.mutable_accesses.store(0, std::memory_order_relaxed);
+        }
+    });
+#endif
 }
 
 } //describe
@@ -0,0 +1,327 @@
+/*
+enums.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_ENUMS_HPP
+#define DESCRIBE_ENUMS_HPP
+#include "describe.hpp"
+#include "span.hpp"
+#include "traits.hpp"
+#include <string>
+
+// Define DESCRIBE_NO_SIMD to force scalar fallbacks
+#ifndef DESCRIBE_NO_SIMD
+#if defined(__AVX2__)
+#define DESCRIBE_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DESCRIBE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace describe
+{
+
+// Enum attribute: values are bitmasks of described members, see flags_to_string() / string_to_flags()
+struct flags {};
+
+namespace detail {
+
+// 4-byte fingerprint of a name: length, first char and two last chars.
+// Candidates are compared by fingerprint (4 or 8 per instruction), then verified
+constexpr uint32_t name_key(std::string_view name) noexcept {
+    if (name.empty()) return 0;
+    auto at = [&](size_t idx) {
+        return uint32_t(uint8_t(name[idx]));
+    };
+    size_t len = name.size();
+    return uint32_t(uint8_t(len)) | at(0) << 8 | at(len > 1 ? len - 2 : 0) << 16 | at(len - 1) << 24;
+}
+
+template<typename E>
+struct enum_name_table {
+    static constexpr auto names = enum_names<E>();
+    static constexpr auto values = enum_values<E>();
+    static constexpr size_t count = names.size();
+    // padded to a whole number of AVX2 registers
+    static constexpr size_t padded = (count + 7) / 8 * 8;
+
+    static constexpr auto make_keys() {
+        std::array<uint32_t, padded ? padded : 8> res{};
+        for (size_t i = 0; i < count; ++i) res[i] = name_key(names[i]);
+        return res;
+    }
+
+    static constexpr auto keys = make_keys();
+
+    // candidates are checked in declaration order -> first described name wins
+    static bool check(uint32_t mask, size_t base, std::string_view name, size_t& out) noexcept {
+        while (mask) {
+            size_t idx = base + ctz(mask);
+            mask &= mask - 1;
+            if (idx < count && names[idx] == name) {
+                out = idx;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool find(std::string_view name, size_t& out) noexcept {
+        const uint32_t key = name_key(name);
+#if defined(DESCRIBE_SIMD_AVX2)
+        const __m256i needle = _mm256_set1_epi32(int(key));
+        for (size_t base = 0; base < padded; base += 8) {
+            __m256i cand = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys.data() + base));
+            __m256i eq = _mm256_cmpeq_epi32(cand, needle);
+            auto mask = uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+            if (mask && check(mask, base, name, out)) return true;
+        }
+#elif defined(DESCRIBE_SIMD_SSE2)
+        const __m128i needle = _mm_set1_epi32(int(key));
+        for (size_t base = 0; base < padded; base += 4) {
+            __m128i cand = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys.data() + base));
+            __m128i eq = _mm_cmpeq_epi32(cand, needle);
+            auto mask = uint32_t(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+            if (mask && check(mask, base, name, out)) return true;
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            if (keys[i] == key && names[i] == name) {
+                out = i;
+                return true;
+            }
+        }
+#endif
+        return false;
+    }
+};
+
+template<typename E>
+struct enum_value_table {
+    using U = std::underlying_type_t<E>;
+    // values are widened to 64 bits, keeping signedness for ordering
+    using Wide = std::conditional_t<std::is_signed_v<U>, int64_t, uint64_t>;
+    static constexpr auto names = enum_names<E>();
+    static constexpr auto values = enum_values<E>();
+    static constexpr size_t count = names.size();
+
+    static constexpr Wide min_value() {
+        Wide res = count ? Wide(values[0]) : 0;
+        for (auto v: values) res = Wide(v) < res ? Wide(v) : res;
+        return res;
+    }
+    static constexpr Wide max_value() {
+        Wide res = count ? Wide(values[0]) : 0;
+        for (auto v: values) res = Wide(v) > res ? Wide(v) : res;
+        return res;
+    }
+
+    static constexpr Wide min = min_value();
+    static constexpr uint64_t range = uint64_t(max_value()) - uint64_t(min);
+    // dense enums get a direct lookup table, sparse ones - a sorted array
+    static constexpr bool dense = range < 256 || range < count * 4;
+    static constexpr size_t lut_size = dense ? size_t(range) + 1 : 1;
+
+    static constexpr auto make_lut() {
+        std::array<int32_t, lut_size> res{};
+        for (auto& i: res) i = -1;
+        if (dense) {
+            for (size_t i = count; i-- > 0;) {
+                res[size_t(uint64_t(Wide(values[i])) - uint64_t(min))] = int32_t(i);
+            }
+        }
+        return res;
+    }
+
+    static constexpr auto make_sorted() {
+        std::array<size_t, count> res{};
+        for (size_t i = 0; i < count; ++i) {
+            size_t j = i;
+            // stable insertion sort -> first described name precedes aliases
+            while (j > 0 && Wide(values[res[j - 1]]) > Wide(values[i])) {
+                res[j] = res[j - 1];
+                j--;
+            }
+            res[j] = i;
+        }
+        return res;
+    }
+
+    static constexpr auto lut = make_lut();
+    static constexpr auto sorted = make_sorted();
+
+    static bool find(E value, size_t& out) noexcept {
+        const auto v = Wide(value);
+        if constexpr (dense) {
+            uint64_t idx = uint64_t(v) - uint64_t(min);
+            if (idx >= lut_size || lut[idx] < 0) return false;
+            out = size_t(lut[idx]);
+            return true;
+        } else {
+            size_t lo = 0, hi = count;
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (Wide(values[sorted[mid]]) < v) lo = mid + 1;
+                else hi = mid;
+            }
+            if (lo == count || Wide(values[sorted[lo]]) != v) return false;
+            out = sorted[lo];
+            return true;
+        }
+    }
+};
+
+template<typename E>
+struct enum_bits_table {
+    using U = std::make_unsigned_t<std::underlying_type_t<E>>;
+    static constexpr auto names = enum_names<E>();
+    static constexpr auto values = enum_values<E>();
+
+    // bit -> index of first single-bit member (-1 if none)
+    static constexpr auto make_by_bit() {
+        std::array<int32_t, sizeof(U) * 8> res{};
+        for (auto& i: res) i = -1;
+        for (size_t i = names.size(); i-- > 0;) {
+            auto v = U(values[i]);
+            if (v && !(v & (v - 1))) res[ctz(v)] = int32_t(i);
+        }
+        return res;
+    }
+
+    static constexpr int32_t zero_index() {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (!U(values[i])) return int32_t(i);
+        }
+        return -1;
+    }
+
+    static constexpr U covered_bits() {
+        U res = 0;
+        for (size_t bit = 0; bit < by_bit.size(); ++bit) {
+            if (by_bit[bit] >= 0) res |= U(U(1) << bit);
+        }
+        return res;
+    }
+
+    static constexpr auto by_bit = make_by_bit();
+    static constexpr int32_t zero = zero_index();
+    static constexpr U covered = covered_bits();
+};
+
+} //detail
+
+// Appends "a|b|c" for each set bit of value (or a name of zero member, if described).
+// False if some bit has no single-bit member (out is untouched then)
+template<typename Enum, if_described_enum_t<Enum, int> = 1>
+[[nodiscard]]
+bool flags_to_string(Enum value, std::string& out, char sep = '|') {
+    static_assert(has_v<flags, Enum>, "flags_to_string(): Enum is not marked with describe::flags");
+    using table = detail::enum_bits_table<Enum>;
+    auto bits = typename table::U(value);
+    if (bits & ~table::covered) return false;
+    if (!bits) {
+        if (table::zero >= 0) out += table::names[size_t(table::zero)];
+        return true;
+    }
+    bool first = true;
+    for (uint64_t rest = bits; rest; rest &= rest - 1) {
+        if (!first) out += sep;
+        first = false;
+        out += table::names[size_t(table::by_bit[detail::ctz(rest)])];
+    }
+    return true;
+}
+
+// Parses "a | b|c" (any described member, including multi-bit ones) in one pass without allocations.
+// Empty string -> zero value. Respects describe::case_insensitive
+template<typename Enum, if_described_enum_t<Enum, int> = 1>
+[[nodiscard]]
+constexpr bool string_to_flags(std::string_view str, Enum& out, char sep = '|') {
+    static_assert(has_v<flags, Enum>, "string_to_flags(): Enum is not marked with describe::flags");
+    using hashed = detail::hashed_enum_names<Enum>;
+    using U = typename detail::enum_bits_table<Enum>::U;
+    U result = 0;
+    typename hashed::folded token{};
+    bool empty = true;
+    bool any = false;
+    size_t spaces = 0; // only kept if followed by more token chars
+    auto take = [&]{
+        Enum value{};
+        if (empty || !hashed::find(token, value)) return false;
+        result |= U(value);
+        token = {};
+        empty = true;
+        spaces = 0;
+        return true;
+    };
+    for (char c: str) {
+        if (c == sep) {
+            if (!take()) return false;
+            any = true;
+        } else if (c == ' ') {
+            spaces += !empty;
+        } else {
+            for (; spaces; --spaces) token.push(' ');
+            token.push(c);
+            empty = false;
+        }
+    }
+    if ((any || !empty) && !take()) return false;
+    out = Enum(result);
+    return true;
+}
+
+// Batched name_to_enum(): returns number of resolved names.
+// `found[i]` (if passed) reports whether `names[i]` matched, unmatched `out[i]` are left untouched.
+// Processes min(names, out, found if passed) items
+template<typename Enum, if_described_enum_t<Enum, int> = 1>
+size_t names_to_enums(span<const std::string_view> names, span<Enum> out, span<bool> found = {}) {
+    using table = detail::enum_name_table<Enum>;
+    size_t count = names.size() < out.size() ? names.size() : out.size();
+    if (!found.empty() && found.size() < count) count = found.size();
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool ok;
+        if constexpr (has_v<case_insensitive, Enum>) {
+            ok = detail::hashed_enum_names<Enum>::find(names[i], out[i]);
+        } else {
+            size_t idx;
+            ok = table::find(names[i], idx);
+            if (ok) out[i] = table::values[idx];
+        }
+        hits += ok;
+        if (!found.empty()) found[i] = ok;
+    }
+    return hits;
+}
+
+// Batched enum_to_name(): returns number of described values.
+// `found[i]` (if passed) reports whether `values[i]` is described, unmatched `out[i]` are left untouched.
+// Processes min(values, out, found if passed) items
+template<typename Enum, if_described_enum_t<Enum, int> = 1>
+size_t enums_to_names(span<const Enum> values, span<std::string_view> out, span<bool> found = {}) {
+    using table = detail::enum_value_table<Enum>;
+    size_t count = values.size() < out.size() ? values.size() : out.size();
+    if (!found.empty() && found.size() < count) count = found.size();
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t idx;
+        bool ok = table::find(values[i], idx);
+        if (ok) {
+            out[i] = table::names[idx];
+            hits++;
+        }
+        if (!found.empty()) found[i] = ok;
+    }
+    return hits;
+}
+
+} //describe
+
+#endif //DESCRIBE_ENUMS_HPP
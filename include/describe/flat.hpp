@@ -0,0 +1,196 @@
+/*
+flat.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_FLAT_HPP
+#define DESCRIBE_FLAT_HPP
+#include "describe.hpp"
+#include "span.hpp"
+#include "traits.hpp"
+
+namespace describe
+{
+
+struct flat_field {
+    std::string_view name;
+    size_t offset; // inside T, npos if virtual_base
+    size_t base_offset; // of subobject that declares the field, npos if virtual_base
+    size_t size;
+    bool virtual_base; // reached through a virtual base -> use Member::get()
+    static constexpr size_t npos = size_t(-1);
+};
+
+namespace detail {
+
+// Every member visited by Get<T>::for_each() (including ones reached through several PARENT()s)
+template<typename T>
+struct flat_info {
+    struct entry {
+        std::string_view name;
+        std::string_view member; // type_key<Member>()
+        uint32_t name_hash; // compared first: pairwise checks below are quadratic
+        bool is_field;
+
+        constexpr bool same_name(const entry& other) const noexcept {
+            return name_hash == other.name_hash && name == other.name;
+        }
+    };
+
+    static constexpr uint32_t hash(std::string_view name) noexcept {
+        uint32_t res = 2166136261u;
+        for (char c: name) res = fnv1a(res, c);
+        return res;
+    }
+
+    static constexpr size_t count_visited() {
+        size_t res = 0;
+        Get<T>::for_each([&](auto){res++;});
+        return res;
+    }
+
+    static constexpr size_t visited = count_visited();
+
+    static constexpr auto make_entries() {
+        std::array<entry, visited> res{};
+        size_t idx = 0;
+        Get<T>::for_each([&](auto f){
+            res[idx++] = {f.name, type_key<decltype(f)>(), hash(f.name), f.is_field};
+        });
+        return res;
+    }
+
+    static constexpr auto entries = make_entries();
+
+    // Same member with the same name seen before -> shared (virtual) base visited again
+    static constexpr auto make_keep() {
+        std::array<bool, visited> res{};
+        for (size_t i = 0; i < visited; ++i) {
+            res[i] = true;
+            for (size_t j = 0; j < i && res[i]; ++j) {
+                if (entries[j].same_name(entries[i]) && entries[j].member == entries[i].member) res[i] = false;
+            }
+        }
+        return res;
+    }
+
+    static constexpr auto keep = make_keep();
+
+    static constexpr size_t count_unique(bool fields_only) {
+        size_t res = 0;
+        for (size_t i = 0; i < visited; ++i) {
+            res += keep[i] && (!fields_only || entries[i].is_field);
+        }
+        return res;
+    }
+
+    static constexpr size_t unique = count_unique(false);
+    static constexpr size_t fields = count_unique(true);
+
+    static constexpr bool names_unique() {
+        for (size_t i = 0; i < visited; ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (keep[i] && keep[j] && entries[i].same_name(entries[j])) return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr bool bases_unambiguous() {
+        bool ok = true;
+        Get<T>::for_each([&](auto f){
+            if constexpr (f.is_field) {
+                ok = ok && unambiguous_base<T, typename decltype(f)::cls>;
+            }
+        });
+        return ok;
+    }
+
+    // evaluated once per T, not per flat_for_each() caller
+    static constexpr bool valid_names = names_unique();
+    static constexpr bool valid_bases = bases_unambiguous();
+};
+
+} //detail
+
+// Like Get<T>::for_each(), but members reached through several PARENT() paths
+// (a shared virtual base) are visited only once. Diagnoses at compile time:
+// fields in ambiguous bases and distinct members with the same name
+template<typename T, typename Fn>
+constexpr void flat_for_each(Fn&& fn) {
+    using info = detail::flat_info<T>;
+    static_assert(info::valid_bases,
+        "flat_for_each(): field is declared in an ambiguous (non-virtual diamond) or inaccessible base");
+    static_assert(info::valid_names,
+        "flat_for_each(): two different members share a name (check overlapping PARENT() hierarchies)");
+    if constexpr (info::unique == info::visited) {
+        Get<T>::for_each([&](auto f){fn(f);});
+    } else {
+        size_t idx = 0;
+        Get<T>::for_each([&](auto f){
+            if (info::keep[idx++]) fn(f);
+        });
+    }
+}
+
+// Like fields_count<T>(), but each field counted once
+template<typename T>
+constexpr size_t flat_fields_count() {
+    return detail::flat_info<T>::fields;
+}
+
+// Like field_names<T>(), but each field listed once
+template<typename T>
+constexpr auto flat_field_names() {
+    std::array<std::string_view, flat_fields_count<T>()> result;
+    size_t idx = 0;
+    flat_for_each<T>([&](auto f){
+        if constexpr (f.is_field) result[idx++] = f.name;
+    });
+    return result;
+}
+
+namespace detail {
+
+// Offsets are not constant expressions in C++17 -> table is filled once on first use
+template<typename T>
+struct flat_table {
+    std::array<flat_field, flat_fields_count<T>()> fields{};
+
+    flat_table() {
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                using C = typename decltype(f)::cls;
+                auto& field = fields[idx++];
+                field.name = f.name;
+                field.size = sizeof(typename decltype(f)::type);
+                if constexpr (via_virtual_base<T, C>) {
+                    field.offset = flat_field::npos;
+                    field.base_offset = flat_field::npos;
+                    field.virtual_base = true;
+                } else {
+                    field.offset = offset_of<T>(f.value);
+                    field.base_offset = base_offset<T, C>();
+                }
+            }
+        });
+    }
+};
+
+} //detail
+
+// Deduplicated fields of T with offsets inside T, in declaration order.
+// Fields at static offsets can be copied as raw bytes (if trivially copyable)
+template<typename T, if_described_struct_t<T, int> = 1>
+span<const flat_field> flat_fields() {
+    static const detail::flat_table<T> table;
+    return table.fields;
+}
+
+} //describe
+
+#endif //DESCRIBE_FLAT_HPP
@@ -0,0 +1,567 @@
+/*
+incremental.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_INCREMENTAL_HPP
+#define DESCRIBE_INCREMENTAL_HPP
+#include "describe.hpp"
+#include "traits.hpp"
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace describe
+{
+
+enum class decode_status : uint8_t {
+    partial,  // waiting for more bytes
+    complete, // root object closed, trailing bytes are not consumed
+    error,
+};
+
+namespace detail {
+
+enum class json_kind : uint8_t {
+    skip,
+    boolean,
+    number,
+    string,
+    enumeration,
+    object,
+};
+
+struct json_object_ops;
+
+// Type-erased destination of a single JSON value
+struct json_target {
+    json_kind kind = json_kind::skip;
+    void* field = nullptr;
+    void* (*engage)(void* field) = nullptr; // std::optional<X>: emplace and return &X
+    void (*disengage)(void* field) = nullptr;
+    void (*set_bool)(void* field, bool value) = nullptr;
+    bool (*set_number)(void* field, std::string_view text) = nullptr;
+    bool (*set_enum)(void* field, std::string_view name) = nullptr;
+    const json_object_ops* nested = nullptr;
+};
+
+struct json_object_ops {
+    bool (*find)(void* object, std::string_view key, json_target& out);
+};
+
+template<typename T> struct json_binding;
+
+template<typename F>
+json_target json_bind(void* field) {
+    json_target res;
+    if constexpr (unwrap_optional<F>::value) {
+        res = json_bind<typename unwrap_optional<F>::type>(nullptr);
+        res.engage = [](void* f) -> void* {
+            auto& opt = *static_cast<F*>(f);
+            if (!opt) opt.emplace();
+            return &*opt;
+        };
+        res.disengage = [](void* f) {
+            static_cast<F*>(f)->reset();
+        };
+    } else if constexpr (std::is_same_v<F, bool>) {
+        res.kind = json_kind::boolean;
+        res.set_bool = [](void* f, bool value) {
+            *static_cast<F*>(f) = value;
+        };
+    } else if constexpr (is_described_enum_v<F>) {
+        res.kind = json_kind::enumeration;
+        res.set_enum = [](void* f, std::string_view name) {
+            return name_to_enum(name, *static_cast<F*>(f));
+        };
+    } else if constexpr (std::is_arithmetic_v<F>) {
+        res.kind = json_kind::number;
+        res.set_number = [](void* f, std::string_view text) {
+            F value{};
+            auto end = text.data() + text.size();
+            auto [ptr, ec] = parse_number(text.data(), end, value);
+            if (ec != std::errc{} || ptr != end) return false;
+            *static_cast<F*>(f) = value;
+            return true;
+        };
+    } else if constexpr (std::is_same_v<F, std::string>) {
+        res.kind = json_kind::string;
+    } else if constexpr (is_described_struct_v<F>) {
+        res.kind = json_kind::object;
+        res.nested = &json_binding<F>::ops;
+    } else {
+        static_assert(always_false<F>, "incremental_decoder: unsupported field type");
+    }
+    res.field = field;
+    return res;
+}
+
+template<typename T>
+struct json_binding {
+    static bool find(void* object, std::string_view key, json_target& out) {
+        auto& obj = *static_cast<T*>(object);
+        bool found = false;
+        Get<T>::for_each([&](auto f){
+            if constexpr (f.is_field) {
+                if (!found && f.name == key) {
+                    out = json_bind<decltype(of(f))>(&f.get(obj));
+                    found = true;
+                }
+            }
+        });
+        return found;
+    }
+    static constexpr json_object_ops ops{find};
+};
+
+// Resumable JSON parser. Writes values directly into bound fields,
+// unknown keys (with any nested values) are skipped
+class json_machine {
+public:
+    static constexpr size_t max_depth = 256;
+
+    void reset(void* root, const json_object_ops* ops) {
+        _stack.clear();
+        _scratch.clear();
+        _target = {};
+        _target.kind = json_kind::object;
+        _target.field = root;
+        _target.nested = ops;
+        _state = state::start;
+        _status = decode_status::partial;
+        _consumed = 0;
+        _surrogate = 0;
+    }
+
+    decode_status feed(const char* data, size_t size) {
+        size_t i = 0;
+        while (i < size && _status == decode_status::partial) {
+            i = step(data, size, i);
+        }
+        _consumed += i;
+        return _status;
+    }
+
+    decode_status status() const noexcept {return _status;}
+    size_t consumed() const noexcept {return _consumed;}
+private:
+    enum class state : uint8_t {
+        start,      // before root '{'
+        value,      // expecting value for _target
+        first_key,  // after '{'
+        key,        // after ',' inside object
+        colon,
+        next,       // after value: ',' or closing bracket
+        first_item, // after '['
+        string,
+        escape,
+        unicode,
+        number,
+        literal,
+    };
+
+    // Position inside a number: -? (0 | [1-9][0-9]*) (.[0-9]+)? ([eE][+-]?[0-9]+)?
+    enum class number_part : uint8_t {
+        sign,      // after '-'
+        zero,      // leading 0, no more integer digits allowed
+        integer,
+        dot,
+        fraction,
+        exponent,  // after 'e'
+        exp_sign,
+        exp_digits,
+    };
+
+    struct frame {
+        void* object; // nullptr -> skipped container
+        const json_object_ops* ops;
+        char close;
+    };
+
+    static bool is_space(char c) noexcept {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    static bool is_number_char(char c) noexcept {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    // Advances _number by c, false if c can not continue the number
+    bool number_next(char c) noexcept {
+        const bool digit = c >= '0' && c <= '9';
+        switch (_number) {
+        case number_part::sign:
+            if (!digit) return false;
+            _number = c == '0' ? number_part::zero : number_part::integer;
+            return true;
+        case number_part::zero:
+        case number_part::integer:
+            if (digit && _number == number_part::integer) return true;
+            if (c == '.') _number = number_part::dot;
+            else if (c == 'e' || c == 'E') _number = number_part::exponent;
+            else return false;
+            return true;
+        case number_part::dot:
+        case number_part::fraction:
+            if (digit) _number = number_part::fraction;
+            else if (_number == number_part::fraction && (c == 'e' || c == 'E')) _number = number_part::exponent;
+            else return false;
+            return true;
+        case number_part::exponent:
+            if (c == '+' || c == '-') _number = number_part::exp_sign;
+            else if (digit) _number = number_part::exp_digits;
+            else return false;
+            return true;
+        case number_part::exp_sign:
+        case number_part::exp_digits:
+            if (!digit) return false;
+            _number = number_part::exp_digits;
+            return true;
+        }
+        return false;
+    }
+
+    size_t fail() noexcept {
+        _status = decode_status::error;
+        return 0;
+    }
+
+    void* field() {
+        if (_target.engage) {
+            _target.field = _target.engage(_target.field);
+            _target.engage = nullptr;
+        }
+        return _target.field;
+    }
+
+    bool push(frame f) {
+        if (_stack.size() == max_depth) return false;
+        _stack.push_back(f);
+        return true;
+    }
+
+    bool close(char c) {
+        if (_stack.empty() || _stack.back().close != c) return false;
+        _stack.pop_back();
+        if (_stack.empty()) {
+            _status = decode_status::complete;
+        } else {
+            _state = state::next;
+        }
+        return true;
+    }
+
+    void begin_key() {
+        _is_key = true;
+        _sink = _stack.back().object ? &_scratch : nullptr;
+        _scratch.clear();
+        _state = state::string;
+    }
+
+    void resolve_key() {
+        auto& top = _stack.back();
+        _target = {};
+        if (top.object && !top.ops->find(top.object, _scratch, _target)) {
+            _target = {};
+        }
+        _state = state::colon;
+    }
+
+    bool begin_value(char c) {
+        switch (c) {
+        case '"':
+            _is_key = false;
+            if (_target.kind == json_kind::string) {
+                _sink = static_cast<std::string*>(field());
+                _sink->clear();
+            } else if (_target.kind == json_kind::enumeration) {
+                _sink = &_scratch;
+                _scratch.clear();
+            } else if (_target.kind == json_kind::skip) {
+                _sink = nullptr;
+            } else {
+                return false;
+            }
+            _state = state::string;
+            return true;
+        case '{':
+            if (_target.kind == json_kind::object) {
+                if (!push({field(), _target.nested, '}'})) return false;
+            } else if (_target.kind == json_kind::skip) {
+                if (!push({nullptr, nullptr, '}'})) return false;
+            } else {
+                return false;
+            }
+            _state = state::first_key;
+            return true;
+        case '[':
+            if (_target.kind != json_kind::skip || !push({nullptr, nullptr, ']'})) return false;
+            _state = state::first_item;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void put(char c) {
+        if (_surrogate) flush_surrogate();
+        if (_sink) *_sink += c;
+    }
+
+    void put_codepoint(uint32_t cp) {
+        if (!_sink) return;
+        if (cp < 0x80) {
+            *_sink += char(cp);
+        } else if (cp < 0x800) {
+            *_sink += char(0xC0 | (cp >> 6));
+            *_sink += char(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            *_sink += char(0xE0 | (cp >> 12));
+            *_sink += char(0x80 | ((cp >> 6) & 0x3F));
+            *_sink += char(0x80 | (cp & 0x3F));
+        } else {
+            *_sink += char(0xF0 | (cp >> 18));
+            *_sink += char(0x80 | ((cp >> 12) & 0x3F));
+            *_sink += char(0x80 | ((cp >> 6) & 0x3F));
+            *_sink += char(0x80 | (cp & 0x3F));
+        }
+    }
+
+    // lone surrogate -> U+FFFD
+    void flush_surrogate() {
+        _surrogate = 0;
+        put_codepoint(0xFFFD);
+    }
+
+    void unicode_done() {
+        uint32_t cp = _unicode;
+        if (_surrogate && cp >= 0xDC00 && cp <= 0xDFFF) {
+            cp = 0x10000 + ((_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+            _surrogate = 0;
+        } else {
+            if (_surrogate) flush_surrogate();
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                _surrogate = cp;
+                return;
+            }
+            if (cp >= 0xDC00 && cp <= 0xDFFF) cp = 0xFFFD;
+        }
+        put_codepoint(cp);
+    }
+
+    bool end_string() {
+        if (_surrogate) flush_surrogate();
+        if (_is_key) {
+            resolve_key();
+            return true;
+        }
+        _state = state::next;
+        if (_target.kind == json_kind::enumeration) {
+            return _target.set_enum(field(), _scratch);
+        }
+        return true;
+    }
+
+    bool end_number() {
+        _state = state::next;
+        if (_number != number_part::zero && _number != number_part::integer
+            && _number != number_part::fraction && _number != number_part::exp_digits) {
+            return false;
+        }
+        if (_target.kind == json_kind::number) {
+            return _target.set_number(field(), _scratch);
+        }
+        return true;
+    }
+
+    bool end_literal() {
+        _state = state::next;
+        if (_literal[0] == 'n') {
+            if (_target.disengage) _target.disengage(_target.field);
+            return _target.disengage || _target.kind == json_kind::skip;
+        }
+        if (_target.kind == json_kind::boolean) {
+            _target.set_bool(field(), _literal[0] == 't');
+            return true;
+        }
+        return _target.kind == json_kind::skip;
+    }
+
+    // Returns index of next char to process
+    size_t step(const char* data, size_t size, size_t i) {
+        char c = data[i];
+        switch (_state) {
+        case state::start:
+            if (is_space(c)) return i + 1;
+            if (c != '{') return fail();
+            _state = state::value;
+            return i;
+        case state::value:
+            if (is_space(c)) return i + 1;
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                if (_target.kind != json_kind::number && _target.kind != json_kind::skip) return fail();
+                _scratch.clear();
+                if (c == '-') {
+                    _number = number_part::sign;
+                } else {
+                    _number = c == '0' ? number_part::zero : number_part::integer;
+                }
+                if (_target.kind != json_kind::skip) _scratch += c;
+                _state = state::number;
+                return i + 1;
+            }
+            if (c == 't' || c == 'f' || c == 'n') {
+                _literal = c == 't' ? "true" : c == 'f' ? "false" : "null";
+                _literal_pos = 0;
+                _state = state::literal;
+                return i;
+            }
+            return begin_value(c) ? i + 1 : fail();
+        case state::first_key:
+            if (is_space(c)) return i + 1;
+            if (c == '}') return close(c) ? i + 1 : fail();
+            if (c != '"') return fail();
+            begin_key();
+            return i + 1;
+        case state::key:
+            if (is_space(c)) return i + 1;
+            if (c != '"') return fail();
+            begin_key();
+            return i + 1;
+        case state::colon:
+            if (is_space(c)) return i + 1;
+            if (c != ':') return fail();
+            _state = state::value;
+            return i + 1;
+        case state::next:
+            if (is_space(c)) return i + 1;
+            if (c == ',') {
+                if (_stack.back().close == '}') {
+                    _state = state::key;
+                } else {
+                    _target = {};
+                    _state = state::value;
+                }
+                return i + 1;
+            }
+            return close(c) ? i + 1 : fail();
+        case state::first_item:
+            if (is_space(c)) return i + 1;
+            if (c == ']') return close(c) ? i + 1 : fail();
+            _target = {};
+            _state = state::value;
+            return i;
+        case state::string: {
+            // copy a run of plain chars at once
+            size_t end = i;
+            while (end < size && data[end] != '"' && data[end] != '\\' && uint8_t(data[end]) >= 0x20) {
+                end++;
+            }
+            if (end != i) {
+                if (_surrogate) flush_surrogate();
+                if (_sink) _sink->append(data + i, end - i);
+                return end;
+            }
+            if (c == '"') return end_string() ? i + 1 : fail();
+            if (c == '\\') {
+                _state = state::escape;
+                return i + 1;
+            }
+            return fail();
+        }
+        case state::escape:
+            _state = state::string;
+            switch (c) {
+            case '"': case '\\': case '/': put(c); break;
+            case 'b': put('\b'); break;
+            case 'f': put('\f'); break;
+            case 'n': put('\n'); break;
+            case 'r': put('\r'); break;
+            case 't': put('\t'); break;
+            case 'u':
+                _unicode = 0;
+                _unicode_digits = 0;
+                _state = state::unicode;
+                break;
+            default: return fail();
+            }
+            return i + 1;
+        case state::unicode: {
+            uint32_t digit;
+            if (c >= '0' && c <= '9') digit = uint32_t(c - '0');
+            else if (c >= 'a' && c <= 'f') digit = uint32_t(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') digit = uint32_t(c - 'A' + 10);
+            else return fail();
+            _unicode = _unicode << 4 | digit;
+            if (++_unicode_digits == 4) {
+                _state = state::string;
+                unicode_done();
+            }
+            return i + 1;
+        }
+        case state::number:
+            if (is_number_char(c)) {
+                if (!number_next(c)) return fail();
+                if (_target.kind != json_kind::skip) _scratch += c;
+                return i + 1;
+            }
+            return end_number() ? i : fail();
+        case state::literal:
+            if (c != _literal[_literal_pos]) return fail();
+            if (!_literal[++_literal_pos] && !end_literal()) return fail();
+            return i + 1;
+        }
+        return fail();
+    }
+
+    std::vector<frame> _stack;
+    std::string _scratch;
+    std::string* _sink = nullptr;
+    json_target _target;
+    const char* _literal = nullptr;
+    size_t _consumed = 0;
+    uint32_t _unicode = 0;
+    uint32_t _surrogate = 0;
+    uint8_t _unicode_digits = 0;
+    uint8_t _literal_pos = 0;
+    bool _is_key = false;
+    number_part _number = number_part::integer;
+    state _state = state::start;
+    decode_status _status = decode_status::partial;
+};
+
+} //detail
+
+// Decodes JSON object into described T as bytes arrive, suspending at any position (even mid-field).
+// Values are written directly into target. Fields: arithmetic, bool, std::string,
+// described enums (by name) and structs, std::optional of those (null -> reset, error for other fields)
+template<typename T>
+class incremental_decoder {
+    static_assert(is_described_struct_v<T>, "incremental_decoder<T>: T must be described");
+public:
+    explicit incremental_decoder(T& target) {
+        reset(target);
+    }
+
+    void reset(T& target) {
+        _machine.reset(&target, &detail::json_binding<T>::ops);
+    }
+
+    decode_status feed(std::string_view chunk) {
+        return _machine.feed(chunk.data(), chunk.size());
+    }
+
+    decode_status status() const noexcept {return _machine.status();}
+    // total bytes consumed. After completion the rest of the last chunk is left for the caller
+    size_t consumed() const noexcept {return _machine.consumed();}
+private:
+    detail::json_machine _machine;
+};
+
+} //describe
+
+#endif //DESCRIBE_INCREMENTAL_HPP
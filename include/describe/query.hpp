@@ -0,0 +1,486 @@
+/*
+query.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_QUERY_HPP
+#define DESCRIBE_QUERY_HPP
+#include "describe.hpp"
+#include "columnar.hpp"
+#include "enums.hpp"
+#include "span.hpp"
+#include "traits.hpp"
+#include <charconv>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace describe
+{
+
+namespace detail {
+
+enum class query_op : uint8_t {
+    eq,
+    ne,
+    lt,
+    le,
+    gt,
+    ge,
+};
+
+enum class query_code : uint8_t {
+    compare, // push(field <op> rhs)
+    all,     // push(pop() & pop())
+    any,     // push(pop() | pop())
+    negate,  // push(~pop())
+};
+
+enum class query_type : uint8_t {
+    sint,
+    uint,
+    real,
+    string,
+    enumeration, // only == and !=
+    unsupported, // field can not be referenced in expressions
+};
+
+struct query_value {
+    int64_t i = 0; // sint, enumeration (underlying value)
+    uint64_t u = 0;
+    double f = 0;
+    int32_t dict = -1; // enumeration: index in columnar dictionary
+    std::string s;
+};
+
+struct query_instr {
+    query_code code = query_code::compare;
+    query_op op = query_op::eq;
+    uint16_t field = 0;
+    query_value rhs;
+};
+
+template<typename Load, typename R>
+uint64_t compare_rows(size_t n, query_op op, const Load& load, const R& rhs) {
+    uint64_t bits = 0;
+    auto run = [&](auto cmp) {
+        for (size_t i = 0; i < n; ++i) bits |= uint64_t(cmp(load(i), rhs)) << i;
+    };
+    switch (op) {
+    case query_op::eq: run(std::equal_to<>{}); break;
+    case query_op::ne: run(std::not_equal_to<>{}); break;
+    case query_op::lt: run(std::less<>{}); break;
+    case query_op::le: run(std::less_equal<>{}); break;
+    case query_op::gt: run(std::greater<>{}); break;
+    case query_op::ge: run(std::greater_equal<>{}); break;
+    }
+    return bits;
+}
+
+template<typename F>
+constexpr query_type query_type_of() {
+    using V = typename unwrap_optional<F>::type;
+    if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view>) {
+        return query_type::string;
+    } else if constexpr (is_described_enum_v<V>) {
+        return query_type::enumeration;
+    } else if constexpr (std::is_enum_v<V>) {
+        return query_type_of<std::underlying_type_t<V>>();
+    } else if constexpr (std::is_floating_point_v<V>) {
+        return query_type::real;
+    } else if constexpr (std::is_same_v<V, bool> || std::is_signed_v<V>) {
+        return query_type::sint;
+    } else if constexpr (std::is_unsigned_v<V>) {
+        return query_type::uint;
+    } else {
+        return query_type::unsupported;
+    }
+}
+
+template<typename T>
+struct query_field {
+    std::string_view name;
+    query_type type = query_type::sint;
+    bool (*resolve)(std::string_view name, query_value& out) = nullptr; // enum name -> value
+    uint64_t (*compare)(const T* rows, size_t n, const query_instr& instr) = nullptr;
+};
+
+template<typename T, typename Mem>
+uint64_t query_compare(const T* rows, size_t n, const query_instr& instr) {
+    using F = typename Mem::type;
+    using V = typename unwrap_optional<F>::type;
+    constexpr auto type = query_type_of<F>();
+    auto value = [&](size_t i) -> V {
+        if constexpr (unwrap_optional<F>::value) return Mem::get(rows[i]).value_or(V{});
+        else return Mem::get(rows[i]);
+    };
+    uint64_t bits;
+    if constexpr (type == query_type::string) {
+        bits = compare_rows(n, instr.op, [&](size_t i) {
+            if constexpr (unwrap_optional<F>::value) {
+                auto& opt = Mem::get(rows[i]);
+                return opt ? std::string_view{*opt} : std::string_view{};
+            } else {
+                return std::string_view{Mem::get(rows[i])};
+            }
+        }, std::string_view{instr.rhs.s});
+    } else if constexpr (type == query_type::sint || type == query_type::enumeration) {
+        bits = compare_rows(n, instr.op, [&](size_t i) {return int64_t(value(i));}, instr.rhs.i);
+    } else if constexpr (type == query_type::uint) {
+        bits = compare_rows(n, instr.op, [&](size_t i) {return uint64_t(value(i));}, instr.rhs.u);
+    } else {
+        bits = compare_rows(n, instr.op, [&](size_t i) {return double(value(i));}, instr.rhs.f);
+    }
+    if constexpr (unwrap_optional<F>::value) {
+        uint64_t present = 0;
+        for (size_t i = 0; i < n; ++i) present |= uint64_t(Mem::get(rows[i]).has_value()) << i;
+        bits &= present;
+    }
+    if constexpr (type == query_type::enumeration) {
+        // undescribed values are nulls, as in columnar dictionaries
+        uint64_t described = 0;
+        for (size_t i = 0; i < n; ++i) {
+            size_t idx;
+            described |= uint64_t(enum_value_table<V>::find(value(i), idx)) << i;
+        }
+        bits &= described;
+    }
+    return bits;
+}
+
+template<typename E>
+bool query_resolve(std::string_view name, query_value& out) {
+    E value;
+    if (!name_to_enum(name, value)) return false;
+    out.i = int64_t(value);
+    out.dict = enum_dictionary<E>::index(value);
+    return true;
+}
+
+template<typename T>
+constexpr auto make_query_fields() {
+    std::array<query_field<T>, flat_fields_count<T>()> res{};
+    size_t idx = 0;
+    flat_for_each<T>([&](auto f){
+        if constexpr (f.is_field) {
+            using F = decltype(of(f));
+            auto& out = res[idx++];
+            out.name = f.name;
+            out.type = query_type_of<F>();
+            if constexpr (query_type_of<F>() != query_type::unsupported) {
+                out.compare = &query_compare<T, decltype(f)>;
+            }
+            if constexpr (query_type_of<F>() == query_type::enumeration) {
+                out.resolve = &query_resolve<typename unwrap_optional<F>::type>;
+            }
+        }
+    });
+    return res;
+}
+
+template<typename V>
+uint64_t compare_fixed(const column& col, size_t base, size_t n, const query_instr& instr) {
+    const V* data = col.values<V>() + base;
+    auto load = [&](size_t i) {return data[i];};
+    if constexpr (std::is_floating_point_v<V>) return compare_rows(n, instr.op, load, instr.rhs.f);
+    else if constexpr (std::is_signed_v<V>) return compare_rows(n, instr.op, load, instr.rhs.i);
+    else return compare_rows(n, instr.op, load, instr.rhs.u);
+}
+
+inline uint64_t compare_column(const column& col, size_t base, size_t n, const query_instr& instr) {
+    uint64_t bits = 0;
+    switch (col.kind) {
+    case column_kind::boolean: {
+        const uint8_t* data = col.values<uint8_t>() + base;
+        bits = compare_rows(n, instr.op, [&](size_t i) {return int64_t(data[i]);}, instr.rhs.i);
+        break;
+    }
+    case column_kind::signed_int:
+        switch (col.width) {
+        case 1: bits = compare_fixed<int8_t>(col, base, n, instr); break;
+        case 2: bits = compare_fixed<int16_t>(col, base, n, instr); break;
+        case 4: bits = compare_fixed<int32_t>(col, base, n, instr); break;
+        default: bits = compare_fixed<int64_t>(col, base, n, instr); break;
+        }
+        break;
+    case column_kind::unsigned_int:
+        switch (col.width) {
+        case 1: bits = compare_fixed<uint8_t>(col, base, n, instr); break;
+        case 2: bits = compare_fixed<uint16_t>(col, base, n, instr); break;
+        case 4: bits = compare_fixed<uint32_t>(col, base, n, instr); break;
+        default: bits = compare_fixed<uint64_t>(col, base, n, instr); break;
+        }
+        break;
+    case column_kind::floating:
+        if (col.width == 4) bits = compare_fixed<float>(col, base, n, instr);
+        else bits = compare_fixed<double>(col, base, n, instr);
+        break;
+    case column_kind::string:
+        bits = compare_rows(n, instr.op, [&](size_t i) {
+            return col.string_at(base + i);
+        }, std::string_view{instr.rhs.s});
+        break;
+    case column_kind::dictionary: {
+        const int32_t* data = col.values<int32_t>() + base;
+        bits = compare_rows(n, instr.op, [&](size_t i) {return data[i];}, instr.rhs.dict);
+        break;
+    }
+    }
+    if (col.nullable) {
+        uint64_t present = 0;
+        const uint8_t* validity = col.validity.data() + base / 8;
+        for (size_t b = 0; b < (n + 7) / 8; ++b) present |= uint64_t(validity[b]) << (b * 8);
+        bits &= present;
+    }
+    return bits;
+}
+
+} //detail
+
+// Runtime predicate over described records: `age > 30 && (type == "ugly" || !active)`.
+// Operands: <field> <op> <literal>, where op is one of == != < <= > >=,
+// literal: number, "string", true, false or enum name (quoted or bare). Bare bool/integer field is `!= 0`.
+// Fields of other types (e.g. containers) are allowed in T, but can not be referenced
+// Nulls (empty optionals, enum values without a described name) never satisfy a comparison
+// Compiled once into postfix bytecode, evaluated 64 rows at a time
+template<typename T>
+class query {
+    static_assert(is_described_struct_v<T>, "query<T>: T must be described");
+public:
+    query() = default;
+    explicit query(std::string_view expr) {
+        (void)compile(expr);
+    }
+
+    // False on error, see error()
+    [[nodiscard]] bool compile(std::string_view expr) {
+        _code.clear();
+        _error.clear();
+        _src = expr;
+        _pos = 0;
+        size_t stack = 0;
+        if (!parse_any(stack, 0)) return false;
+        skip_spaces();
+        if (_pos != _src.size()) return fail("unexpected input");
+        return true;
+    }
+
+    bool valid() const noexcept {return !_code.empty() && _error.empty();}
+    std::string_view error() const noexcept {return _error;}
+
+    bool matches(const T& row) const {
+        return run(1, [&](const detail::query_instr& instr, size_t, size_t) {
+            return fields[instr.field].compare(&row, 1, instr);
+        }, nullptr);
+    }
+
+    // Appends indices of matching rows to out, returns number of matches
+    size_t select(span<const T> rows, std::vector<uint32_t>& out) const {
+        return run(rows.size(), [&](const detail::query_instr& instr, size_t base, size_t n) {
+            return fields[instr.field].compare(rows.data() + base, n, instr);
+        }, &out);
+    }
+
+    // Same over columns: only referenced columns are scanned
+    size_t select(const columnar_writer<T>& columns, std::vector<uint32_t>& out) const {
+        return run(columns.rows(), [&](const detail::query_instr& instr, size_t base, size_t n) {
+            return detail::compare_column(columns[instr.field], base, n, instr);
+        }, &out);
+    }
+private:
+    static constexpr auto fields = detail::make_query_fields<T>();
+    static constexpr size_t max_nesting = 64;
+
+    template<typename Compare>
+    size_t run(size_t rows, const Compare& compare, std::vector<uint32_t>* out) const {
+        if (!valid()) return 0;
+        uint64_t stack[max_nesting + 2];
+        size_t total = 0;
+        for (size_t base = 0; base < rows; base += 64) {
+            const size_t n = rows - base < 64 ? rows - base : 64;
+            const uint64_t mask = n == 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+            size_t sp = 0;
+            for (auto& instr: _code) {
+                switch (instr.code) {
+                case detail::query_code::compare: stack[sp++] = compare(instr, base, n); break;
+                case detail::query_code::all: sp--; stack[sp - 1] &= stack[sp]; break;
+                case detail::query_code::any: sp--; stack[sp - 1] |= stack[sp]; break;
+                case detail::query_code::negate: stack[sp - 1] = ~stack[sp - 1]; break;
+                }
+            }
+            for (uint64_t bits = stack[0] & mask; bits; bits &= bits - 1) {
+                if (out) out->push_back(uint32_t(base + detail::ctz(bits)));
+                total++;
+            }
+        }
+        return total;
+    }
+
+    bool fail(const char* msg) {
+        _error = msg;
+        _error += " at position ";
+        _error += std::to_string(_pos);
+        _code.clear();
+        return false;
+    }
+
+    void skip_spaces() {
+        while (_pos < _src.size() && (_src[_pos] == ' ' || _src[_pos] == '\t' || _src[_pos] == '\n')) _pos++;
+    }
+
+    bool eat(std::string_view token) {
+        skip_spaces();
+        if (_src.substr(_pos, token.size()) != token) return false;
+        _pos += token.size();
+        return true;
+    }
+
+    static bool is_ident(char c, bool first) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || (!first && c >= '0' && c <= '9');
+    }
+
+    std::string_view ident() {
+        skip_spaces();
+        size_t start = _pos;
+        while (_pos < _src.size() && is_ident(_src[_pos], _pos == start)) _pos++;
+        return _src.substr(start, _pos - start);
+    }
+
+    // binary op: pops 2, pushes 1
+    void emit(detail::query_code code, size_t& stack) {
+        _code.emplace_back().code = code;
+        stack--;
+    }
+
+    bool parse_any(size_t& stack, size_t nesting) {
+        if (!parse_all(stack, nesting)) return false;
+        while (eat("||")) {
+            if (!parse_all(stack, nesting)) return false;
+            emit(detail::query_code::any, stack);
+        }
+        return true;
+    }
+
+    bool parse_all(size_t& stack, size_t nesting) {
+        if (!parse_unary(stack, nesting)) return false;
+        while (eat("&&")) {
+            if (!parse_unary(stack, nesting)) return false;
+            emit(detail::query_code::all, stack);
+        }
+        return true;
+    }
+
+    bool parse_unary(size_t& stack, size_t nesting) {
+        if (nesting > max_nesting || stack > max_nesting) return fail("expression is too deep");
+        skip_spaces();
+        if (_src.substr(_pos, 2) != "!=" && eat("!")) {
+            if (!parse_unary(stack, nesting + 1)) return false;
+            _code.emplace_back().code = detail::query_code::negate;
+            return true;
+        }
+        if (eat("(")) {
+            if (!parse_any(stack, nesting + 1)) return false;
+            if (!eat(")")) return fail("expected ')'");
+            return true;
+        }
+        return parse_compare(stack);
+    }
+
+    bool parse_op(detail::query_op& op) {
+        using detail::query_op;
+        if (eat("==")) op = query_op::eq;
+        else if (eat("!=")) op = query_op::ne;
+        else if (eat("<=")) op = query_op::le;
+        else if (eat(">=")) op = query_op::ge;
+        else if (eat("<")) op = query_op::lt;
+        else if (eat(">")) op = query_op::gt;
+        else return false;
+        return true;
+    }
+
+    bool parse_string(std::string& out) {
+        const char quote = _src[_pos++];
+        while (_pos < _src.size() && _src[_pos] != quote) {
+            if (_src[_pos] == '\\' && _pos + 1 < _src.size()) _pos++;
+            out += _src[_pos++];
+        }
+        if (_pos == _src.size()) return false;
+        _pos++;
+        return true;
+    }
+
+    bool parse_compare(size_t& stack) {
+        using detail::query_type;
+        auto name = ident();
+        if (name.empty()) return fail("expected field name");
+        size_t field = 0;
+        while (field < fields.size() && fields[field].name != name) field++;
+        if (field == fields.size()) return fail("unknown field");
+        auto& info = fields[field];
+        if (info.type == query_type::unsupported) return fail("unsupported field");
+        detail::query_instr instr;
+        instr.field = uint16_t(field);
+        if (!parse_op(instr.op)) {
+            // bare integer/bool field: `active` -> `active != 0`
+            if (info.type != query_type::sint && info.type != query_type::uint) {
+                return fail("expected comparison operator");
+            }
+            instr.op = detail::query_op::ne;
+            _code.push_back(std::move(instr));
+            stack++;
+            return true;
+        }
+        skip_spaces();
+        if (_pos == _src.size()) return fail("expected value");
+        auto& rhs = instr.rhs;
+        const char c = _src[_pos];
+        if (c == '"' || c == '\'') {
+            if (!parse_string(rhs.s)) return fail("unterminated string");
+            if (info.type == query_type::enumeration) {
+                if (!info.resolve(rhs.s, rhs)) return fail("unknown enum value");
+            } else if (info.type != query_type::string) {
+                return fail("string compared to non-string field");
+            }
+        } else if (is_ident(c, true)) {
+            auto word = ident();
+            if (info.type == query_type::enumeration) {
+                if (!info.resolve(word, rhs)) return fail("unknown enum value");
+            } else if ((word == "true" || word == "false") && info.type == query_type::sint) {
+                rhs.i = word == "true";
+            } else {
+                return fail("unexpected identifier");
+            }
+        } else {
+            auto begin = _src.data() + _pos;
+            auto end = _src.data() + _src.size();
+            std::from_chars_result res{};
+            switch (info.type) {
+            case query_type::sint: res = detail::parse_number(begin, end, rhs.i); break;
+            case query_type::uint: res = detail::parse_number(begin, end, rhs.u); break;
+            case query_type::real: res = detail::parse_number(begin, end, rhs.f); break;
+            default: return fail("number compared to non-numeric field");
+            }
+            if (res.ec != std::errc{}) return fail("invalid number");
+            _pos += size_t(res.ptr - begin);
+        }
+        if (info.type == query_type::enumeration && instr.op != detail::query_op::eq && instr.op != detail::query_op::ne) {
+            return fail("enums only support == and !=");
+        }
+        _code.push_back(std::move(instr));
+        stack++;
+        return true;
+    }
+
+    std::vector<detail::query_instr> _code;
+    std::string _error;
+    std::string_view _src;
+    size_t _pos = 0;
+};
+
+} //describe
+
+#endif //DESCRIBE_QUERY_HPP
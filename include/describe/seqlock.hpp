@@ -0,0 +1,208 @@
+/*
+seqlock.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_SEQLOCK_HPP
+#define DESCRIBE_SEQLOCK_HPP
+#include "describe.hpp"
+#include "flat.hpp"
+#include <atomic>
+#include <thread>
+#include <utility>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+#include <stdint.h>
+#include <string.h>
+
+namespace describe
+{
+
+namespace detail {
+
+using seq_word = uintptr_t;
+
+template<typename F>
+constexpr size_t words_for() {
+    return (sizeof(F) + sizeof(seq_word) - 1) / sizeof(seq_word);
+}
+
+// Field index (see flat_for_each()) -> first word of its storage
+template<typename T>
+constexpr auto seq_layout() {
+    std::array<size_t, flat_fields_count<T>() + 1> res{};
+    size_t idx = 0;
+    flat_for_each<T>([&](auto f){
+        if constexpr (f.is_field) {
+            res[idx + 1] = res[idx] + words_for<typename decltype(f)::type>();
+            idx++;
+        }
+    });
+    return res;
+}
+
+template<typename T, auto field>
+constexpr size_t seq_field_index() {
+    size_t idx = 0;
+    size_t res = size_t(-1);
+    flat_for_each<T>([&](auto f){
+        if constexpr (f.is_field) {
+            if constexpr (std::is_same_v<std::remove_cv_t<decltype(f.value)>, decltype(field)>) {
+                if (f.value == field && res == size_t(-1)) res = idx;
+            }
+            idx++;
+        }
+    });
+    return res;
+}
+
+// Spin-wait hint while the writer is in the middle of a publication
+inline void seq_pause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+template<typename F>
+void seq_store(std::atomic<seq_word>* dst, const F& value) noexcept {
+    seq_word buff[words_for<F>()] = {};
+    memcpy(buff, &value, sizeof(F));
+    for (size_t i = 0; i < words_for<F>(); ++i) {
+        dst[i].store(buff[i], std::memory_order_relaxed);
+    }
+}
+
+template<typename F>
+void seq_load(const std::atomic<seq_word>* src, F& value) noexcept {
+    seq_word buff[words_for<F>()];
+    for (size_t i = 0; i < words_for<F>(); ++i) {
+        buff[i] = src[i].load(std::memory_order_relaxed);
+    }
+    memcpy(&value, buff, sizeof(F));
+}
+
+} //detail
+
+// Single writer, many lock-free readers: readers never take a lock, but spin while a publication
+// is in progress and retry if one overlapped their copy (so constant writes can delay them).
+// Only described fields are published:
+// each is copied word by word through relaxed atomics, so torn reads are detected
+// (and retried) without data races. Fields must be trivially copyable.
+// Concurrent writers must be serialized by the caller
+template<typename T>
+class seqlock {
+    static_assert(is_described_struct_v<T>, "seqlock<T>: T must be described");
+    static constexpr auto layout = detail::seq_layout<T>();
+    static constexpr size_t words = layout.back() ? layout.back() : 1;
+
+    static constexpr bool fields_trivial() {
+        bool ok = true;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                ok = ok && std::is_trivially_copyable_v<typename decltype(f)::type>;
+            }
+        });
+        return ok;
+    }
+    static_assert(fields_trivial(), "seqlock<T>: all described fields must be trivially copyable");
+public:
+    seqlock() : seqlock(T{}) {}
+    explicit seqlock(const T& init) : current(init) {
+        publish();
+    }
+    seqlock(const seqlock&) = delete;
+    seqlock& operator=(const seqlock&) = delete;
+
+    // Writer: modify a private copy of the state with fn(T&), then publish it
+    template<typename Fn>
+    void update(Fn&& fn) {
+        fn(current);
+        publish();
+    }
+    void store(const T& value) {
+        current = value;
+        publish();
+    }
+    // Writer-side view of the last published state
+    const T& writer_state() const noexcept {
+        return current;
+    }
+
+    // Reader: consistent copy of all described fields (other members are default-initialized)
+    T snapshot() const noexcept {
+        T res{};
+        read([&]{
+            size_t idx = 0;
+            flat_for_each<T>([&](auto f){
+                if constexpr (f.is_field) {
+                    detail::seq_load(data + layout[idx++], f.get(res));
+                }
+            });
+        });
+        return res;
+    }
+
+    // Reader: consistent copy of a single field
+    template<auto field>
+    auto load() const noexcept {
+        constexpr size_t idx = detail::seq_field_index<T, field>();
+        static_assert(idx != size_t(-1), "seqlock<T>::load(): field is not described");
+        std::remove_cv_t<std::remove_reference_t<decltype(std::declval<T&>().*field)>> res;
+        read([&]{
+            detail::seq_load(data + layout[idx], res);
+        });
+        return res;
+    }
+
+    // Number of publications so far
+    uint64_t version() const noexcept {
+        return seq.load(std::memory_order_acquire) / 2;
+    }
+private:
+    void publish() noexcept {
+        const uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        // odd sequence must become visible before any of the new data
+        std::atomic_thread_fence(std::memory_order_release);
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                detail::seq_store(data + layout[idx++], f.get(std::as_const(current)));
+            }
+        });
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    template<typename Fn>
+    void read(Fn&& copy) const noexcept {
+        for (;;) {
+            const uint64_t before = seq.load(std::memory_order_acquire);
+            if (before & 1) {
+                detail::seq_pause();
+                continue;
+            }
+            copy();
+            // data loads must complete before the sequence is re-checked
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) return;
+        }
+    }
+
+    alignas(64) std::atomic<uint64_t> seq{0};
+    std::atomic<detail::seq_word> data[words];
+    alignas(64) T current;
+};
+
+} //describe
+
+#endif //DESCRIBE_SEQLOCK_HPP
@@ -0,0 +1,201 @@
+/*
+shape.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_SHAPE_HPP
+#define DESCRIBE_SHAPE_HPP
+#include "describe.hpp"
+#include "span.hpp"
+#include "traits.hpp"
+#include <string>
+#include <string_view>
+#include <string.h>
+
+// Define DESCRIBE_SHAPE_ERASED to make serializers that support it (e.g. write_csv())
+// interpret shape_of<T>() tables in shared non-template loops instead of instantiating
+// a for_each() chain per type: smaller binaries at the cost of a switch per field
+
+namespace describe
+{
+
+// How an erased serializer should read a field at `offset`
+enum class shape_kind : uint8_t {
+    boolean,
+    signed_int, // `size` bytes
+    unsigned_int, // `size` bytes
+    floating, // float or double
+    string, // std::string
+    string_view, // std::string_view
+    enumeration, // described enum, see `enumeration`
+    nested, // described struct, see `nested`
+};
+
+struct shape_enum {
+    span<const std::string_view> names;
+    span<const uint64_t> values; // widened, sign-extended if is_signed
+    bool is_signed;
+};
+
+struct shape;
+
+struct shape_field {
+    std::string_view name;
+    size_t offset;
+    shape_kind kind;
+    uint8_t size;
+    const shape* nested; // shape_kind::nested only
+    const shape_enum* enumeration; // shape_kind::enumeration only
+};
+
+struct shape {
+    std::string_view name;
+    size_t size;
+    span<const shape_field> fields;
+};
+
+namespace detail {
+
+template<typename E>
+struct shape_enum_table {
+    using U = std::underlying_type_t<E>;
+    static constexpr auto names = enum_names<E>();
+
+    static constexpr auto make_values() {
+        std::array<uint64_t, names.size()> res{};
+        size_t idx = 0;
+        for (auto v: enum_values<E>()) {
+            if constexpr (std::is_signed_v<U>) res[idx++] = uint64_t(int64_t(v));
+            else res[idx++] = uint64_t(v);
+        }
+        return res;
+    }
+
+    static constexpr auto values = make_values();
+    static constexpr shape_enum table{names, values, std::is_signed_v<U>};
+};
+
+template<typename F>
+struct shape_type {
+    static constexpr bool is_nested = is_described_struct_v<F>;
+    static constexpr bool supported =
+        std::is_same_v<F, std::string> || std::is_same_v<F, std::string_view>
+        || is_described_enum_v<F> || is_nested
+        || (std::is_integral_v<F> && sizeof(F) <= 8)
+        || std::is_same_v<F, float> || std::is_same_v<F, double>;
+
+    static constexpr shape_kind kind() {
+        if constexpr (std::is_same_v<F, std::string>) return shape_kind::string;
+        else if constexpr (std::is_same_v<F, std::string_view>) return shape_kind::string_view;
+        else if constexpr (is_described_enum_v<F>) return shape_kind::enumeration;
+        else if constexpr (is_nested) return shape_kind::nested;
+        else if constexpr (std::is_same_v<F, bool>) return shape_kind::boolean;
+        else if constexpr (std::is_floating_point_v<F>) return shape_kind::floating;
+        else if constexpr (std::is_signed_v<F>) return shape_kind::signed_int;
+        else return shape_kind::unsigned_int;
+    }
+};
+
+// True if every field (recursively) has a shape_kind and a static offset
+template<typename T>
+constexpr bool shape_erasable() {
+    bool ok = true;
+    Get<T>::for_each([&](auto f){
+        if constexpr (f.is_field) {
+            using F = typename decltype(f)::type;
+            if constexpr (!shape_type<F>::supported || via_virtual_base<T, typename decltype(f)::cls>) {
+                ok = false;
+            } else if constexpr (shape_type<F>::is_nested) {
+                ok = ok && shape_erasable<F>();
+            }
+        }
+    });
+    return ok;
+}
+
+// True if shape_erasable() and there are no nested structs
+template<typename T>
+constexpr bool shape_flat() {
+    bool ok = shape_erasable<T>();
+    Get<T>::for_each([&](auto f){
+        if constexpr (f.is_field) {
+            ok = ok && !shape_type<typename decltype(f)::type>::is_nested;
+        }
+    });
+    return ok;
+}
+
+template<typename T>
+const shape& shape_of();
+
+// Offsets are not constant expressions in C++17 -> table is filled once on first use
+template<typename T>
+struct shape_holder {
+    std::array<shape_field, fields_count<T>()> fields{};
+    shape value;
+
+    shape_holder() : value{Get<T>::name, sizeof(T), fields} {
+        size_t idx = 0;
+        Get<T>::for_each([&](auto f){
+            if constexpr (f.is_field) {
+                using F = typename decltype(f)::type;
+                using traits = shape_type<F>;
+                auto& field = fields[idx++];
+                field.name = f.name;
+                field.offset = offset_of<T>(f.value);
+                field.kind = traits::kind();
+                field.size = uint8_t(traits::is_nested ? 0 : sizeof(F));
+                if constexpr (traits::is_nested) {
+                    field.nested = &shape_of<F>();
+                } else if constexpr (is_described_enum_v<F>) {
+                    field.enumeration = &shape_enum_table<F>::table;
+                }
+            }
+        });
+    }
+};
+
+template<typename T>
+const shape& shape_of() {
+    static const shape_holder<T> holder;
+    return holder.value;
+}
+
+// Reads integer of `size` bytes (sign-extended if is_signed)
+inline uint64_t shape_read_int(const unsigned char* at, uint8_t size, bool is_signed) noexcept {
+    switch (size) {
+    case 1: {int8_t v; memcpy(&v, at, 1); return is_signed ? uint64_t(int64_t(v)) : uint8_t(v);}
+    case 2: {int16_t v; memcpy(&v, at, 2); return is_signed ? uint64_t(int64_t(v)) : uint16_t(v);}
+    case 4: {int32_t v; memcpy(&v, at, 4); return is_signed ? uint64_t(int64_t(v)) : uint32_t(v);}
+    default: {uint64_t v; memcpy(&v, at, 8); return v;}
+    }
+}
+
+} //detail
+
+// Type-erased descriptor of described struct T (fields with offsets, kinds and nested tables).
+// Available for types where every field is an arithmetic type, std::string(_view),
+// described enum or another such struct (see detail::shape_erasable<T>())
+template<typename T, if_described_struct_t<T, int> = 1>
+const shape& shape_of() {
+    static_assert(detail::shape_erasable<T>(), "shape_of<T>(): some field has no shape_kind");
+    return detail::shape_of<T>();
+}
+
+// Name of described enum value from its erased representation (false if not described)
+inline bool shape_enum_name(const shape_enum& table, uint64_t value, std::string_view& out) noexcept {
+    for (size_t i = 0; i < table.values.size(); ++i) {
+        if (table.values[i] == value) {
+            out = table.names[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+} //describe
+
+#endif //DESCRIBE_SHAPE_HPP
@@ -0,0 +1,298 @@
+/*
+sort.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_SORT_HPP
+#define DESCRIBE_SORT_HPP
+#include "describe.hpp"
+#include "flat.hpp"
+#include "span.hpp"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <string.h>
+
+namespace describe
+{
+
+// Base of sort attributes (query with extract_t<sort_field, Member>)
+struct sort_field {};
+
+// Field takes part in radix_sort() / sorted_index(). Fields with lower Priority are compared first,
+// equal priorities - in order of description
+template<int Priority = 0>
+struct sort_key : sort_field {
+    static constexpr int priority = Priority;
+};
+
+// Field (that also has sort_key<>) is sorted from greater to smaller
+struct sort_descending {};
+
+namespace detail {
+
+// Bytes of string fields that go into radix keys, longer equal prefixes are compared afterwards
+constexpr size_t sort_prefix = 8;
+
+template<typename F>
+struct sort_traits {
+    static constexpr bool is_string = std::is_same_v<F, std::string> || std::is_same_v<F, std::string_view>;
+    static constexpr bool supported = is_string || std::is_enum_v<F> || std::is_integral_v<F>
+        || std::is_same_v<F, float> || std::is_same_v<F, double>;
+    static constexpr size_t width = is_string ? sort_prefix : sizeof(F);
+};
+
+template<typename U>
+void sort_store(U value, uint8_t* out) noexcept {
+    for (size_t i = sizeof(U); i-- > 0;) {
+        out[i] = uint8_t(value);
+        value = U(value >> 8);
+    }
+}
+
+// Writes order-preserving big-endian key: memcmp() of keys orders like operator< of values
+template<typename F>
+void sort_encode(const F& value, uint8_t* out) noexcept {
+    if constexpr (sort_traits<F>::is_string) {
+        const size_t len = value.size() < sort_prefix ? value.size() : sort_prefix;
+        memcpy(out, value.data(), len);
+        memset(out + len, 0, sort_prefix - len);
+    } else if constexpr (std::is_enum_v<F>) {
+        sort_encode(std::underlying_type_t<F>(value), out);
+    } else if constexpr (std::is_same_v<F, bool>) {
+        out[0] = uint8_t(value);
+    } else if constexpr (std::is_floating_point_v<F>) {
+        using Bits = std::conditional_t<sizeof(F) == 4, uint32_t, uint64_t>;
+        constexpr Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+        const F canonical = value == F(0) ? F(0) : value; // -0.0 == 0.0
+        Bits bits;
+        memcpy(&bits, &canonical, sizeof(F));
+        sort_store(Bits(bits & sign ? ~bits : bits | sign), out);
+    } else {
+        using U = std::make_unsigned_t<F>;
+        constexpr U sign = std::is_signed_v<F> ? U(U(1) << (sizeof(U) * 8 - 1)) : U(0);
+        sort_store(U(U(value) ^ sign), out);
+    }
+}
+
+template<typename F>
+int sort_compare(const F& a, const F& b) noexcept {
+    if constexpr (sort_traits<F>::is_string) {
+        int res = std::string_view(a).compare(std::string_view(b));
+        return (res > 0) - (res < 0);
+    } else {
+        return (b < a) - (a < b);
+    }
+}
+
+template<typename T>
+struct sort_plan {
+    static constexpr size_t fields = flat_fields_count<T>();
+
+    struct key_info {
+        bool is_key;
+        bool is_string;
+        bool descending;
+        int priority;
+        size_t width;
+        size_t offset;
+    };
+
+    static constexpr auto make_keys() {
+        std::array<key_info, fields> res{};
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                auto& key = res[idx++];
+                using attr = extract_t<sort_field, decltype(f)>;
+                if constexpr (!std::is_void_v<attr>) {
+                    key.is_key = true;
+                    key.is_string = sort_traits<typename decltype(f)::type>::is_string;
+                    key.descending = has_v<sort_descending, decltype(f)>;
+                    key.priority = attr::priority;
+                    key.width = sort_traits<typename decltype(f)::type>::width;
+                }
+            }
+        });
+        // keys are laid out by (priority, field index)
+        for (size_t i = 0; i < fields; ++i) {
+            for (size_t j = 0; j < fields; ++j) {
+                bool before = res[j].priority < res[i].priority || (res[j].priority == res[i].priority && j < i);
+                if (res[i].is_key && res[j].is_key && before) res[i].offset += res[j].width;
+            }
+        }
+        return res;
+    }
+
+    static constexpr auto keys = make_keys();
+
+    static constexpr size_t total_width() {
+        size_t res = 0;
+        for (auto& key: keys) res += key.width;
+        return res;
+    }
+
+    static constexpr size_t width = total_width();
+
+    static constexpr bool has_strings() {
+        bool res = false;
+        for (auto& key: keys) res = res || (key.is_key && key.is_string);
+        return res;
+    }
+
+    // Key bytes up to the end of the first string key: rows equal there may still differ
+    // after the string prefix and must be finished with less()
+    static constexpr size_t exact_prefix() {
+        size_t res = width;
+        for (auto& key: keys) {
+            if (key.is_key && key.is_string && key.offset + key.width < res) res = key.offset + key.width;
+        }
+        return res;
+    }
+
+    static constexpr bool check_fields() {
+        bool ok = true;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                if constexpr (has_v<sort_field, decltype(f)>) {
+                    ok = ok && sort_traits<typename decltype(f)::type>::supported;
+                }
+            }
+        });
+        return ok;
+    }
+
+    // Fields are counted while walking: MEMBER()s over the same pointer share a type, not an index
+    static void encode(const T& row, uint8_t* out) noexcept {
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                const auto& key = keys[idx++];
+                if constexpr (has_v<sort_field, decltype(f)>) {
+                    sort_encode(f.get(row), out + key.offset);
+                    if (key.descending) {
+                        for (size_t i = 0; i < key.width; ++i) out[key.offset + i] = uint8_t(~out[key.offset + i]);
+                    }
+                }
+            }
+        });
+    }
+
+    // Full comparison of key fields (strings are not truncated)
+    static bool less(const T& a, const T& b) noexcept {
+        std::array<int, fields> cmp{};
+        size_t idx = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                const size_t current = idx++;
+                if constexpr (has_v<sort_field, decltype(f)>) {
+                    int res = sort_compare(f.get(a), f.get(b));
+                    cmp[current] = keys[current].descending ? -res : res;
+                }
+            }
+        });
+        int result = 0;
+        int best = 0;
+        bool found = false;
+        for (size_t i = 0; i < fields; ++i) {
+            if (cmp[i] && (!found || keys[i].priority < best)) {
+                result = cmp[i];
+                best = keys[i].priority;
+                found = true;
+            }
+        }
+        return result < 0;
+    }
+};
+
+template<size_t W>
+struct sort_entry {
+    uint8_t key[W];
+    uint32_t index;
+};
+
+// LSD radix sort by key bytes (stable). Passes where all entries share the byte are skipped
+template<size_t W>
+void sort_entries(std::vector<sort_entry<W>>& items) {
+    const size_t count = items.size();
+    if (count < 2) return;
+    std::vector<uint32_t> hist(W * 256);
+    for (auto& item: items) {
+        for (size_t b = 0; b < W; ++b) hist[b * 256 + item.key[b]]++;
+    }
+    std::vector<sort_entry<W>> tmp(count);
+    for (size_t b = W; b-- > 0;) {
+        uint32_t* counts = hist.data() + b * 256;
+        if (counts[items[0].key[b]] == count) continue;
+        uint32_t sum = 0;
+        for (size_t i = 0; i < 256; ++i) {
+            uint32_t c = counts[i];
+            counts[i] = sum;
+            sum += c;
+        }
+        for (auto& item: items) tmp[counts[item.key[b]]++] = item;
+        items.swap(tmp);
+    }
+}
+
+} //detail
+
+// Fills `out` with indices of `rows` in sorted order (by sort_key<> fields, stable).
+// Rows are not moved. rows.size() must fit into uint32_t
+template<typename T, if_described_struct_t<T, int> = 1>
+void sorted_index(span<const T> rows, std::vector<uint32_t>& out) {
+    using plan = detail::sort_plan<T>;
+    static_assert(plan::width > 0, "sorted_index(): T has no describe::sort_key<> fields");
+    static_assert(plan::check_fields(), "sorted_index(): sort_key<> field must be arithmetic, enum or string");
+    constexpr size_t W = plan::width;
+    std::vector<detail::sort_entry<W>> items(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        plan::encode(rows[i], items[i].key);
+        items[i].index = uint32_t(i);
+    }
+    detail::sort_entries(items);
+    out.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i) out[i] = items[i].index;
+    if constexpr (plan::has_strings()) {
+        // rows that tie up to the end of the first string prefix are ordered by the rest of
+        // that string before any later key
+        constexpr size_t P = plan::exact_prefix();
+        auto less = [&](uint32_t a, uint32_t b){return plan::less(rows[a], rows[b]);};
+        size_t first = 0;
+        for (size_t i = 1; i <= items.size(); ++i) {
+            if (i == items.size() || memcmp(items[i].key, items[first].key, P)) {
+                if (i - first > 1) std::stable_sort(out.begin() + first, out.begin() + i, less);
+                first = i;
+            }
+        }
+    }
+}
+
+// Sorts rows in place by sort_key<> fields (stable): radix sort of keys, then every row is moved once
+template<typename T, if_described_struct_t<T, int> = 1>
+void radix_sort(span<T> rows) {
+    std::vector<uint32_t> perm;
+    sorted_index(span<const T>{rows.data(), rows.size()}, perm);
+    // perm[i] -> row that goes to position i, follow cycles
+    for (size_t i = 0; i < perm.size(); ++i) {
+        if (perm[i] == i) continue;
+        T tmp = std::move(rows[i]);
+        size_t j = i;
+        while (perm[j] != i) {
+            const size_t next = perm[j];
+            rows[j] = std::move(rows[next]);
+            perm[j] = uint32_t(j);
+            j = next;
+        }
+        rows[j] = std::move(tmp);
+        perm[j] = uint32_t(j);
+    }
+}
+
+} //describe
+
+#endif //DESCRIBE_SORT_HPP
@@ -0,0 +1,49 @@
+/*
+span.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_SPAN_HPP
+#define DESCRIBE_SPAN_HPP
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+namespace describe
+{
+
+// Minimal C++17 stand-in for std::span<T> (accepts it too, as well as any contiguous container)
+template<typename T>
+struct span {
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+
+    constexpr span() noexcept = default;
+    constexpr span(T* data, size_t size) noexcept : _data(data), _size(size) {}
+    template<size_t N>
+    constexpr span(T (&arr)[N]) noexcept : _data(arr), _size(N) {}
+    template<typename C, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<C>, span>
+        && std::is_convertible_v<decltype(std::declval<C&>().data()), T*>>>
+    constexpr span(C&& cont) noexcept : _data(cont.data()), _size(cont.size()) {}
+
+    constexpr T* data() const noexcept {return _data;}
+    constexpr size_t size() const noexcept {return _size;}
+    constexpr bool empty() const noexcept {return !_size;}
+    constexpr T* begin() const noexcept {return _data;}
+    constexpr T* end() const noexcept {return _data + _size;}
+    constexpr T& operator[](size_t idx) const noexcept {return _data[idx];}
+    constexpr span subspan(size_t offset, size_t count) const noexcept {
+        return {_data + offset, count};
+    }
+private:
+    T* _data = nullptr;
+    size_t _size = 0;
+};
+
+} //describe
+
+#endif //DESCRIBE_SPAN_HPP
@@ -0,0 +1,146 @@
+/*
+traits.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_TRAITS_HPP
+#define DESCRIBE_TRAITS_HPP
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace describe::detail
+{
+
+template<typename T> struct unwrap_optional {
+    using type = T;
+    static constexpr bool value = false;
+};
+
+template<typename T> struct unwrap_optional<std::optional<T>> {
+    using type = T;
+    static constexpr bool value = true;
+};
+
+template<typename T> constexpr bool always_false = false;
+
+// Distinct string per type, comparable in constant expressions (e.g. to tell Member<> types apart).
+// Addresses of per-type variables are not: GCC refuses to compare them with -fsanitize=address
+template<typename T>
+constexpr std::string_view type_key() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+// count trailing zeroes, bits != 0
+constexpr unsigned ctz(uint64_t bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_ctzll(bits));
+#else
+    unsigned res = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        res++;
+    }
+    return res;
+#endif
+}
+
+template<typename Base, typename T, typename = void>
+struct downcastable : std::false_type {};
+
+template<typename Base, typename T>
+struct downcastable<Base, T, std::void_t<decltype(static_cast<const T*>(std::declval<const Base*>()))>>
+    : std::true_type {};
+
+// Base is reachable from T only through a virtual base (downcast is ill-formed) -> its offset is dynamic
+template<typename T, typename Base>
+constexpr bool via_virtual_base = !std::is_same_v<T, Base>
+    && std::is_convertible_v<const T*, const Base*>
+    && !downcastable<Base, T>::value;
+
+// False for non-virtual diamonds (several Base subobjects) and inaccessible bases
+template<typename T, typename Base>
+constexpr bool unambiguous_base = std::is_same_v<T, Base> || std::is_convertible_v<const T*, const Base*>;
+
+// Offset of Base subobject inside T
+template<typename T, typename Base>
+size_t base_offset() noexcept {
+    static_assert(!via_virtual_base<T, Base>, "base_offset(): offset of virtual base is not static");
+    alignas(T) static unsigned char storage[sizeof(T)];
+    auto obj = reinterpret_cast<const T*>(storage);
+    return size_t(reinterpret_cast<const unsigned char*>(static_cast<const Base*>(obj)) - storage);
+}
+
+// Offset of data member inside T (must not be reached through a virtual base)
+template<typename T, typename M, typename C>
+size_t offset_of(M C::* field) noexcept {
+    static_assert(!via_virtual_base<T, C>, "offset_of(): member of virtual base has no static offset");
+    alignas(T) static unsigned char storage[sizeof(T)];
+    auto obj = reinterpret_cast<const T*>(storage);
+    return size_t(reinterpret_cast<const unsigned char*>(&(obj->*field)) - storage);
+}
+
+// std::from_chars() for floating point via strtod() on a NUL-terminated copy (decimal format only,
+// no inf/nan). For standard libraries without floating-point from_chars (libstdc++ < 11, libc++ < 20).
+// Like strtod(), honors the decimal point of the current C locale
+template<typename F>
+std::from_chars_result strtod_chars(const char* begin, const char* end, F& out) {
+    size_t len = 0;
+    while (begin + len < end) {
+        const char c = begin[len];
+        if (!(c >= '0' && c <= '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') break;
+        len++;
+    }
+    if (!len || begin[0] == '+') return {begin, std::errc::invalid_argument};
+    char small[64];
+    std::string large;
+    const char* text = small;
+    if (len < sizeof(small)) {
+        memcpy(small, begin, len);
+        small[len] = 0;
+    } else {
+        large.assign(begin, len);
+        text = large.c_str();
+    }
+    char* stop = nullptr;
+    errno = 0;
+    F value;
+    if constexpr (std::is_same_v<F, float>) value = strtof(text, &stop);
+    else if constexpr (std::is_same_v<F, double>) value = strtod(text, &stop);
+    else value = strtold(text, &stop);
+    if (stop == text) return {begin, std::errc::invalid_argument};
+    const char* ptr = begin + (stop - text);
+    if (errno == ERANGE) return {ptr, std::errc::result_out_of_range};
+    out = value;
+    return {ptr, std::errc{}};
+}
+
+// std::from_chars() for arithmetic types, floating point falls back to strtod_chars()
+// where the standard library does not announce it (__cpp_lib_to_chars)
+template<typename F>
+std::from_chars_result parse_number(const char* begin, const char* end, F& out) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    return std::from_chars(begin, end, out);
+#else
+    if constexpr (std::is_floating_point_v<F>) return strtod_chars(begin, end, out);
+    else return std::from_chars(begin, end, out);
+#endif
+}
+
+} //describe::detail
+
+#endif //DESCRIBE_TRAITS_HPP
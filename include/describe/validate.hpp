@@ -0,0 +1,180 @@
+/*
+validate.hpp
+
+MIT License
+
+Copyright (c) 2025 Doronin Alexej
+Full license text is in describe.hpp
+*/
+#ifndef DESCRIBE_VALIDATE_HPP
+#define DESCRIBE_VALIDATE_HPP
+#include "describe.hpp"
+#include "flat.hpp"
+#include "span.hpp"
+#include "traits.hpp"
+#include <vector>
+
+namespace describe
+{
+
+// Base of all field validators (query with extract_all_t<field_validator, Member>)
+struct field_validator {};
+
+// Field must be within [Min, Max] (enums are compared via underlying type, NaN is out of range).
+// Empty std::optional is valid: add valid_if<> to require a value
+template<auto Min, auto Max>
+struct valid_range : field_validator {
+    static constexpr auto min = Min;
+    static constexpr auto max = Max;
+};
+
+// Field is valid if fn(const Field&) returns true (std::optional fields are passed as is)
+template<auto fn>
+struct valid_if : field_validator {
+    static constexpr auto check = fn;
+};
+
+struct validation_error {
+    size_t row;
+    uint64_t fields; // bit N -> N-th field of flat_field_names<T>() failed
+};
+
+struct validation_result {
+    size_t rows = 0;
+    std::vector<uint64_t> failed; // bit per row
+    std::vector<validation_error> errors; // only failed rows, ascending
+
+    bool ok() const noexcept {return errors.empty();}
+    bool row_failed(size_t row) const noexcept {
+        return (failed[row / 64] >> (row % 64)) & 1;
+    }
+};
+
+namespace detail {
+
+template<auto a, auto b> std::true_type is_range(const valid_range<a, b>*);
+std::false_type is_range(...);
+
+template<auto fn> std::true_type is_check(const valid_if<fn>*);
+std::false_type is_check(...);
+
+template<typename A, typename B>
+constexpr bool cmp_less(A a, B b) noexcept {
+    if constexpr (!std::is_integral_v<A> || !std::is_integral_v<B>) {
+        return a < b;
+    } else if constexpr (std::is_signed_v<A> == std::is_signed_v<B>) {
+        return a < b;
+    } else if constexpr (std::is_signed_v<A>) {
+        return (a < 0) | (std::make_unsigned_t<A>(a) < b);
+    } else {
+        return (b > 0) & (a < std::make_unsigned_t<B>(b));
+    }
+}
+
+template<typename V, typename F>
+constexpr bool violates(const F& field) {
+    if constexpr (decltype(is_check(static_cast<V*>(nullptr)))::value) {
+        return !V::check(field);
+    } else if constexpr (unwrap_optional<F>::value) {
+        return field && violates<V>(*field);
+    } else if constexpr (std::is_enum_v<F>) {
+        return violates<V>(std::underlying_type_t<F>(field));
+    } else if constexpr (std::is_floating_point_v<F>) {
+        return !(field >= V::min) | !(field <= V::max);
+    } else {
+        return cmp_less(field, V::min) | cmp_less(V::max, field);
+    }
+}
+
+template<typename F, typename T, typename Mem, typename...V>
+void validate_column(span<const T> rows, Mem f, uint64_t* out, TypeList<V...>) {
+    static_assert(((decltype(is_range(static_cast<V*>(nullptr)))::value
+                    || decltype(is_check(static_cast<V*>(nullptr)))::value) && ...),
+                  "validate_batch(): field validators must derive from valid_range<> or valid_if<>");
+    const size_t count = rows.size();
+    for (size_t base = 0; base < count; base += 64) {
+        const size_t n = count - base < 64 ? count - base : 64;
+        uint64_t bits = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const F& field = f.get(rows[base + i]);
+            bits |= uint64_t((false | ... | violates<V>(field))) << i;
+        }
+        out[base / 64] = bits;
+    }
+}
+
+template<typename T>
+constexpr size_t validated_fields_count() {
+    size_t res = 0;
+    flat_for_each<T>([&](auto f){
+        if constexpr (f.is_field) {
+            res += extract_all_t<field_validator, decltype(f)>::size > 0;
+        }
+    });
+    return res;
+}
+
+// indexes (among fields) of fields with validators
+template<typename T>
+constexpr auto validated_fields() {
+    std::array<size_t, validated_fields_count<T>()> res{};
+    size_t field = 0;
+    size_t idx = 0;
+    flat_for_each<T>([&](auto f){
+        if constexpr (f.is_field) {
+            if (extract_all_t<field_validator, decltype(f)>::size > 0) res[idx++] = field;
+            field++;
+        }
+    });
+    return res;
+}
+
+} //detail
+
+// Checks every validator attribute of every row, one field (column) at a time without branching
+// on results. Never throws: failed rows are reported in `out` (previous storage is reused)
+template<typename T, if_described_struct_t<T, int> = 1>
+void validate_batch(span<const T> rows, validation_result& out) {
+    constexpr auto fields = detail::validated_fields<T>();
+    constexpr size_t checked = fields.size();
+    static_assert(!checked || fields[checked - 1] < 64, "validate_batch(): only first 64 fields can have validators");
+    const size_t words = (rows.size() + 63) / 64;
+    out.rows = rows.size();
+    out.failed.assign(words, 0);
+    out.errors.clear();
+    if constexpr (checked > 0) {
+        std::vector<uint64_t> per_field(checked * words);
+        size_t current = 0;
+        flat_for_each<T>([&](auto f){
+            if constexpr (f.is_field) {
+                using validators = extract_all_t<field_validator, decltype(f)>;
+                if constexpr (validators::size > 0) {
+                    uint64_t* bits = per_field.data() + current++ * words;
+                    detail::validate_column<decltype(of(f))>(rows, f, bits, validators{});
+                    for (size_t w = 0; w < words; ++w) out.failed[w] |= bits[w];
+                }
+            }
+        });
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = out.failed[w]; bits; bits &= bits - 1) {
+                const unsigned bit = detail::ctz(bits);
+                validation_error err{w * 64 + bit, 0};
+                for (size_t i = 0; i < checked; ++i) {
+                    err.fields |= ((per_field[i * words + w] >> bit) & 1) << fields[i];
+                }
+                out.errors.push_back(err);
+            }
+        }
+    }
+}
+
+template<typename T, if_described_struct_t<T, int> = 1>
+validation_result validate_batch(span<const T> rows) {
+    validation_result res;
+    validate_batch<T>(rows, res);
+    return res;
+}
+
+} //describe
+
+#endif //DESCRIBE_VALIDATE_HPP
@@ -2,6 +2,18 @@
 #include <iostream>
 #include <type_traits>
 
+bool test_columnar();
+bool test_enum_batch();
+bool test_flags();
+bool test_incremental();
+bool test_validate();
+bool test_query();
+bool test_convert();
+bool test_seqlock();
+bool test_shape();
+bool test_flat();
+bool test_sort();
+
 struct Data {
     int a;
     int b;
@@ -74,5 +86,38 @@ int main(int argc, char *argv[])
     if (describe::name_to_enum("asd", value)) {
         return 1;
     }
+    if (!test_columnar()) {
+        return 1;
+    }
+    if (!test_enum_batch()) {
+        return 1;
+    }
+    if (!test_flags()) {
+        return 1;
+    }
+    if (!test_incremental()) {
+        return 1;
+    }
+    if (!test_validate()) {
+        return 1;
+    }
+    if (!test_query()) {
+        return 1;
+    }
+    if (!test_convert()) {
+        return 1;
+    }
+    if (!test_seqlock()) {
+        return 1;
+    }
+    if (!test_shape()) {
+        return 1;
+    }
+    if (!test_flat()) {
+        return 1;
+    }
+    if (!test_sort()) {
+        return 1;
+    }
     return 0;
 }
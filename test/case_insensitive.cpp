@@ -0,0 +1,52 @@
+#include <describe/describe.hpp>
+#include <string_view>
+
+enum class Access {
+    read,
+    write,
+    read_write,
+};
+
+DESCRIBE("Access", Access, describe::case_insensitive) {
+    MEMBER("read", _::read);
+    MEMBER("write", _::write);
+    MEMBER("read_write", _::read_write);
+    MEMBER("RW", _::read_write);
+}
+
+enum class Loose {
+    read_only,
+    write_only,
+};
+
+DESCRIBE("Loose", Loose, describe::separator_insensitive) {
+    MEMBER("read_only", _::read_only);
+    MEMBER("ReadOnly", _::read_only); // folds into the same name
+    MEMBER("write-only", _::write_only);
+}
+
+template<typename E>
+constexpr bool parses(std::string_view name, E expected) {
+    E res{};
+    return describe::name_to_enum(name, res) && res == expected;
+}
+
+template<typename E>
+constexpr bool rejects(std::string_view name) {
+    E res{};
+    return !describe::name_to_enum(name, res);
+}
+
+static_assert(parses("READ", Access::read));
+static_assert(parses("Read_Write", Access::read_write));
+static_assert(parses("rw", Access::read_write));
+static_assert(rejects<Access>("ReadWrite"));
+static_assert(rejects<Access>("read_write_"));
+static_assert(rejects<Access>(""));
+
+static_assert(parses("ReadOnly", Loose::read_only));
+static_assert(parses("READ-ONLY", Loose::read_only));
+static_assert(parses("write_only", Loose::write_only));
+static_assert(parses("Write Only", Loose::write_only));
+static_assert(rejects<Loose>("readonl"));
+static_assert(rejects<Loose>("read_only_x"));
@@ -0,0 +1,82 @@
+#include <describe/columnar.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace columnar_test {
+
+enum class Kind {
+    alpha,
+    beta,
+    gamma,
+};
+
+DESCRIBE("Kind", Kind) {
+    MEMBER("alpha", _::alpha);
+    MEMBER("a", _::alpha);
+    MEMBER("beta", _::beta);
+    MEMBER("gamma", _::gamma);
+}
+
+struct Record {
+    int32_t id;
+    double score;
+    bool active;
+    std::string label;
+    Kind kind;
+    std::optional<uint16_t> extra;
+};
+
+DESCRIBE("Record", Record) {
+    MEMBER("id", &_::id);
+    MEMBER("score", &_::score);
+    MEMBER("active", &_::active);
+    MEMBER("label", &_::label);
+    MEMBER("kind", &_::kind);
+    MEMBER("extra", &_::extra);
+}
+
+static_assert(describe::detail::enum_dictionary<Kind>::size == 3);
+static_assert(describe::detail::enum_dictionary<Kind>::names[1] == "beta");
+static_assert(describe::detail::enum_dictionary<Kind>::index(Kind::gamma) == 2);
+
+} //columnar_test
+
+using namespace columnar_test;
+
+bool test_columnar() {
+    std::vector<Record> records{
+        {1, 0.5, true, "one", Kind::alpha, 7},
+        {2, 1.5, false, "two, \"quoted\"", Kind::gamma, std::nullopt},
+        {3, -2, true, "", Kind(42), 9},
+    };
+    describe::columnar_writer<Record> writer;
+    writer.append(describe::span<const Record>{records.data(), 2});
+    writer.append(records[2]);
+    if (writer.rows() != 3) return false;
+
+    auto& ids = writer[0];
+    if (ids.kind != describe::column_kind::signed_int || ids.width != 4) return false;
+    if (ids.values<int32_t>()[2] != 3 || ids.nullable) return false;
+    if (writer[1].values<double>()[1] != 1.5) return false;
+    if (writer[2].kind != describe::column_kind::boolean || writer[2].values<bool>()[1]) return false;
+
+    auto& labels = writer[3];
+    if (labels.offsets.size() != 4 || labels.string_at(0) != "one" || labels.string_at(2) != "") return false;
+
+    auto& kinds = writer[4];
+    if (kinds.kind != describe::column_kind::dictionary || kinds.dictionary.size() != 3) return false;
+    if (kinds.values<int32_t>()[1] != 2 || kinds.valid(2) || kinds.null_count != 1) return false;
+
+    auto& extra = writer[5];
+    if (!extra.valid(0) || extra.valid(1) || !extra.valid(2) || extra.null_count != 1) return false;
+    if (extra.values<uint16_t>()[2] != 9) return false;
+
+    std::string csv;
+    describe::write_csv<Record>(records, csv);
+    return csv ==
+        "id,score,active,label,kind,extra\n"
+        "1,0.5,true,one,alpha,7\n"
+        "2,1.5,false,\"two, \"\"quoted\"\"\",gamma,\n"
+        "3,-2,true,,42,9\n";
+}
@@ -0,0 +1,202 @@
+#include <describe/convert.hpp>
+#include <string>
+
+namespace convert_test {
+
+enum class WireColor {
+    red,
+    green,
+};
+
+DESCRIBE("WireColor", WireColor) {
+    MEMBER("red", _::red);
+    MEMBER("green", _::green);
+}
+
+enum class Color {
+    green = 10,
+    red = 20,
+    blue = 30,
+};
+
+DESCRIBE("Color", Color) {
+    MEMBER("green", _::green);
+    MEMBER("red", _::red);
+    MEMBER("blue", _::blue);
+}
+
+struct WirePoint {
+    int32_t x;
+    int32_t y;
+};
+
+DESCRIBE("WirePoint", WirePoint) {
+    MEMBER("x", &_::x);
+    MEMBER("y", &_::y);
+}
+
+struct Point {
+    int64_t x;
+    int64_t y;
+};
+
+DESCRIBE("Point", Point) {
+    MEMBER("x", &_::x);
+    MEMBER("y", &_::y);
+}
+
+struct Dto {
+    int32_t a;
+    int32_t b;
+    double c;
+    std::string name;
+    WireColor color;
+    WirePoint pos;
+    int unused;
+};
+
+DESCRIBE("Dto", Dto) {
+    MEMBER("a", &_::a);
+    MEMBER("b", &_::b);
+    MEMBER("c", &_::c);
+    MEMBER("name", &_::name);
+    MEMBER("color", &_::color);
+    MEMBER("pos", &_::pos);
+    MEMBER("unused", &_::unused);
+}
+
+struct Domain {
+    int32_t a;
+    int32_t b;
+    double c;
+    Color color;
+    std::string title;
+    std::string name;
+    Point pos;
+};
+
+DESCRIBE("Domain", Domain) {
+    MEMBER("c", &_::c); // order of description does not matter
+    MEMBER("b", &_::b);
+    MEMBER("a", &_::a);
+    MEMBER("color", &_::color);
+    MEMBER("title", &_::title);
+    MEMBER("name", &_::name);
+    MEMBER("pos", &_::pos);
+}
+
+struct Header {
+    uint32_t id;
+    uint32_t flags;
+};
+
+DESCRIBE("Header", Header) {
+    MEMBER("id", &_::id);
+    MEMBER("flags", &_::flags);
+}
+
+struct Packet : Header {
+    uint64_t size;
+};
+
+DESCRIBE("Packet", Packet) {
+    PARENT(Header);
+    MEMBER("size", &_::size);
+}
+
+struct FlatPacket {
+    uint32_t id;
+    uint32_t flags;
+    uint64_t size;
+};
+
+DESCRIBE("FlatPacket", FlatPacket) {
+    MEMBER("id", &_::id);
+    MEMBER("flags", &_::flags);
+    MEMBER("size", &_::size);
+}
+
+struct Single {
+    int32_t x;
+};
+
+// same pointer under two names
+DESCRIBE("Single", Single) {
+    MEMBER("x", &_::x);
+    MEMBER("xx", &_::x);
+}
+
+struct Pair {
+    int64_t x;
+    int64_t xx;
+};
+
+DESCRIBE("Pair", Pair) {
+    MEMBER("x", &_::x);
+    MEMBER("xx", &_::xx);
+}
+
+struct IntBox {
+    int v;
+};
+
+DESCRIBE("IntBox", IntBox) {
+    MEMBER("v", &_::v);
+}
+
+struct TextBox {
+    std::string v;
+};
+
+DESCRIBE("TextBox", TextBox) {
+    MEMBER("v", &_::v);
+}
+
+// b2 has no counterpart: TextBox must never be converted from IntBox
+struct Boxes {
+    TextBox b2;
+    IntBox b;
+};
+
+DESCRIBE("Boxes", Boxes) {
+    MEMBER("b2", &_::b2);
+    MEMBER("b", &_::b);
+}
+
+struct BoxSource {
+    IntBox b;
+    int n;
+};
+
+DESCRIBE("BoxSource", BoxSource) {
+    MEMBER("b", &_::b);
+    MEMBER("n", &_::n);
+}
+
+using plan = describe::detail::convert_plan<Domain, Dto>;
+using packet_plan = describe::detail::convert_plan<FlatPacket, Packet>;
+static_assert(plan::match[0] == 2 && plan::match[4] == plan::npos && plan::match[6] == 5);
+static_assert(plan::max_runs == 3);
+
+} //convert_test
+
+using namespace convert_test;
+
+bool test_convert() {
+    Dto dto{1, 2, 3.5, "dto", WireColor::green, {7, 8}, 9};
+    auto dom = describe::convert<Domain>(dto);
+    if (plan::runs().count != 1 || plan::runs().data[0].size != 16) return false;
+    if (dom.a != 1 || dom.b != 2 || dom.c != 3.5 || dom.name != "dto" || !dom.title.empty()) return false;
+    if (dom.color != Color::green || dom.pos.x != 7 || dom.pos.y != 8) return false;
+    dom.color = Color::blue; // has no WireColor -> left untouched
+    dom.a = 5;
+    auto flat = describe::convert<FlatPacket>(Packet{{1, 2}, 3});
+    // inherited fields are at static offsets too -> single run
+    if (packet_plan::runs().count != 1 || flat.id != 1 || flat.flags != 2 || flat.size != 3) return false;
+    auto pair = describe::convert<Pair>(Single{42});
+    if (pair.x != 42 || pair.xx != 42) return false;
+    auto boxes = describe::convert<Boxes>(BoxSource{{3}, 4});
+    if (boxes.b.v != 3 || !boxes.b2.v.empty()) return false;
+    auto back = describe::convert<Dto>(dom);
+    return back.a == 5 && back.c == 3.5 && back.color == WireColor::red && back.pos.y == 8 && back.unused == 0;
+}
@@ -0,0 +1,96 @@
+#include <describe/enums.hpp>
+#include <string_view>
+#include <vector>
+
+namespace enum_batch_test {
+
+enum Color {
+    red,
+    green,
+    blue,
+    cyan,
+    magenta,
+    yellow,
+    black,
+    white,
+    grey,
+};
+
+DESCRIBE("Color", Color) {
+    MEMBER("red", red);
+    MEMBER("green", green);
+    MEMBER("blue", blue);
+    MEMBER("cyan", cyan);
+    MEMBER("magenta", magenta);
+    MEMBER("yellow", yellow);
+    MEMBER("black", black);
+    MEMBER("white", white);
+    MEMBER("grey", grey);
+    MEMBER("gray", grey);
+    MEMBER("block", grey); // same fingerprint as "black"
+    MEMBER("r", red);
+}
+
+enum class Sparse : int64_t {
+    low = -100000,
+    mid = 7,
+    high = 1ll << 40,
+};
+
+DESCRIBE("Sparse", Sparse) {
+    MEMBER("low", _::low);
+    MEMBER("mid", _::mid);
+    MEMBER("middle", _::mid);
+    MEMBER("high", _::high);
+}
+
+enum Level {
+    debug,
+    info,
+};
+
+DESCRIBE("Level", Level, describe::case_insensitive) {
+    MEMBER("debug", debug);
+    MEMBER("info", info);
+}
+
+static_assert(describe::detail::enum_value_table<Color>::dense);
+static_assert(!describe::detail::enum_value_table<Sparse>::dense);
+static_assert(describe::detail::name_key("black") == describe::detail::name_key("block"));
+
+} //enum_batch_test
+
+using namespace enum_batch_test;
+
+bool test_enum_batch() {
+    std::vector<std::string_view> names{"gray", "r", "white", "purple", "", "block", "black"};
+    std::vector<Color> colors(names.size(), black);
+    bool found[7];
+    if (describe::names_to_enums<Color>(names, colors, found) != 5) return false;
+    const Color expected[] = {grey, red, white, black, black, grey, black};
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (colors[i] != expected[i]) return false;
+    }
+    if (!found[0] || found[3] || found[4] || !found[6]) return false;
+
+    std::vector<std::string_view> back(colors.size());
+    if (describe::enums_to_names<Color>(colors, back) != colors.size()) return false;
+    if (back[0] != "grey" || back[1] != "red" || back[3] != "black") return false;
+
+    std::vector<Sparse> sparse{Sparse::high, Sparse::mid, Sparse(3), Sparse::low};
+    std::vector<std::string_view> sparse_names(sparse.size());
+    if (describe::enums_to_names<Sparse>(sparse, sparse_names) != 3) return false;
+    if (sparse_names[0] != "high" || sparse_names[1] != "mid" || sparse_names[3] != "low") return false;
+    std::string_view levels[] = {"DEBUG", "Info", "warn"};
+    Level parsed_levels[3] = {};
+    if (describe::names_to_enums<Level>(levels, parsed_levels) != 2 || parsed_levels[1] != info) return false;
+
+    std::string_view parse[] = {"middle", "low", "lo"};
+    Sparse parsed[3] = {};
+    // shorter `found` limits the batch
+    bool found_short[1] = {};
+    if (describe::names_to_enums<Sparse>(parse, parsed, found_short) != 1 || !found_short[0]) return false;
+    if (describe::enums_to_names<Sparse>(sparse, sparse_names, found_short) != 1) return false;
+    return describe::names_to_enums<Sparse>(parse, parsed) == 2
+        && parsed[0] == Sparse::mid && parsed[1] == Sparse::low;
+}
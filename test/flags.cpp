@@ -0,0 +1,71 @@
+#include <describe/enums.hpp>
+#include <string>
+
+namespace flags_test {
+
+enum Perm : uint8_t {
+    none = 0,
+    read = 1 << 0,
+    write = 1 << 1,
+    exec = 1 << 2,
+    all = read | write | exec,
+    sticky = 1 << 7,
+};
+
+DESCRIBE("Perm", Perm, describe::flags) {
+    MEMBER("none", none);
+    MEMBER("read", read);
+    MEMBER("write", write);
+    MEMBER("exec", exec);
+    MEMBER("all", all);
+}
+
+enum class Opt {
+    verbose = 1,
+    dry_run = 2,
+};
+
+DESCRIBE("Opt", Opt, describe::flags, describe::separator_insensitive) {
+    MEMBER("verbose", _::verbose);
+    MEMBER("dry_run", _::dry_run);
+}
+
+template<typename E>
+constexpr bool parses(std::string_view str, E expected, char sep = '|') {
+    E res{};
+    return describe::string_to_flags(str, res, sep) && res == expected;
+}
+
+template<typename E>
+constexpr bool rejects(std::string_view str) {
+    E res{};
+    return !describe::string_to_flags(str, res);
+}
+
+static_assert(parses("read|exec", Perm(read | exec)));
+static_assert(parses(" read |  write ", Perm(read | write)));
+static_assert(parses("all", all));
+static_assert(parses("none", none));
+static_assert(parses("", none));
+static_assert(parses("  ", none));
+static_assert(parses("read,write", Perm(read | write), ','));
+static_assert(rejects<Perm>("read||write"));
+static_assert(rejects<Perm>("read|"));
+static_assert(rejects<Perm>("re ad"));
+static_assert(rejects<Perm>("READ"));
+static_assert(parses("DryRun | VERBOSE", Opt(3)));
+
+} //flags_test
+
+using namespace flags_test;
+
+bool test_flags() {
+    std::string out;
+    if (!describe::flags_to_string(Perm(read | exec), out) || out != "read|exec") return false;
+    out.clear();
+    if (!describe::flags_to_string(none, out) || out != "none") return false;
+    out.clear();
+    if (describe::flags_to_string(Perm(read | sticky), out) || !out.empty()) return false;
+    if (!describe::flags_to_string(Opt(3), out, ',') || out != "verbose,dry_run") return false;
+    return true;
+}
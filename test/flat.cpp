@@ -0,0 +1,144 @@
+#include <describe/columnar.hpp>
+#include <describe/flat.hpp>
+#include <string>
+
+namespace flat_test {
+
+struct Root {
+    int id;
+};
+
+DESCRIBE("Root", Root) {
+    MEMBER("id", &_::id);
+}
+
+struct Left : virtual Root {
+    double left;
+};
+
+DESCRIBE("Left", Left) {
+    PARENT(Root);
+    MEMBER("left", &_::left);
+}
+
+struct Right : virtual Root {
+    double right;
+};
+
+DESCRIBE("Right", Right) {
+    PARENT(Root);
+    MEMBER("right", &_::right);
+}
+
+struct Diamond : Left, Right {
+    std::string name;
+};
+
+DESCRIBE("Diamond", Diamond) {
+    PARENT(Left);
+    PARENT(Right);
+    MEMBER("name", &_::name);
+}
+
+struct LeftPlain : Root {};
+DESCRIBE("LeftPlain", LeftPlain) {
+    PARENT(Root);
+}
+
+struct RightPlain : Root {};
+DESCRIBE("RightPlain", RightPlain) {
+    PARENT(Root);
+}
+
+// two Root subobjects
+struct Ambiguous : LeftPlain, RightPlain {};
+DESCRIBE("Ambiguous", Ambiguous) {
+    PARENT(LeftPlain);
+    PARENT(RightPlain);
+}
+
+struct Base {
+    uint32_t a;
+    uint32_t b;
+};
+
+DESCRIBE("Base", Base) {
+    MEMBER("a", &_::a);
+    MEMBER("b", &_::b);
+}
+
+struct Derived : Base {
+    uint32_t c;
+};
+
+DESCRIBE("Derived", Derived) {
+    PARENT(Base);
+    MEMBER("c", &_::c);
+}
+
+// shadows Base::a under the same name
+struct Shadow : Base {
+    uint32_t a;
+};
+
+DESCRIBE("Shadow", Shadow) {
+    PARENT(Base);
+    MEMBER("a", &_::a);
+}
+
+using info = describe::detail::flat_info<Diamond>;
+static_assert(describe::fields_count<Diamond>() == 5);
+static_assert(info::visited == 5 && info::unique == 4);
+static_assert(describe::flat_fields_count<Diamond>() == 4);
+static_assert(describe::flat_field_names<Diamond>()[2] == "right");
+static_assert(info::names_unique() && info::bases_unambiguous());
+
+static_assert(describe::detail::via_virtual_base<Diamond, Root>);
+static_assert(!describe::detail::via_virtual_base<Diamond, Left>);
+static_assert(!describe::detail::via_virtual_base<Derived, Base>);
+static_assert(!describe::detail::unambiguous_base<Ambiguous, Root>);
+static_assert(!describe::detail::flat_info<Ambiguous>::bases_unambiguous());
+static_assert(!describe::detail::flat_info<Shadow>::names_unique());
+static_assert(describe::detail::flat_info<Derived>::names_unique());
+
+constexpr size_t count_ids() {
+    size_t res = 0;
+    describe::flat_for_each<Diamond>([&](auto f){
+        res += f.name == "id";
+    });
+    return res;
+}
+
+static_assert(count_ids() == 1);
+static_assert(describe::columnar_writer<Diamond>::columns_count == 4);
+
+} //flat_test
+
+using namespace flat_test;
+
+bool test_flat() {
+    auto diamond = describe::flat_fields<Diamond>();
+    if (diamond.size() != 4 || diamond[0].name != "id" || !diamond[0].virtual_base) return false;
+    if (diamond[1].virtual_base || diamond[1].size != sizeof(double)) return false;
+    Diamond d;
+    auto at = [&](const void* field) {
+        return size_t(static_cast<const char*>(field) - reinterpret_cast<const char*>(&d));
+    };
+    if (diamond[2].offset != at(&d.right) || diamond[2].base_offset != at(static_cast<Right*>(&d))) return false;
+    if (diamond[3].offset != at(&d.name) || diamond[3].base_offset != 0) return false;
+
+    // shared Root is written once
+    Diamond rows[1];
+    rows[0].id = 7;
+    rows[0].left = 1;
+    rows[0].right = 2;
+    rows[0].name = "x";
+    std::string csv;
+    describe::write_csv<Diamond>(rows, csv);
+    if (csv != "id,left,right,name\n7,1,2,x\n") return false;
+
+    auto derived = describe::flat_fields<Derived>();
+    if (derived.size() != 3) return false;
+    // inherited fields are contiguous with own ones -> one run of raw bytes
+    return derived[0].offset == 0 && derived[1].offset == 4 && derived[2].offset == 8;
+}
@@ -0,0 +1,123 @@
+#include <describe/incremental.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace incremental_test {
+
+enum class Level {
+    low,
+    high,
+};
+
+DESCRIBE("Level", Level) {
+    MEMBER("low", _::low);
+    MEMBER("high", _::high);
+}
+
+struct Inner {
+    double ratio;
+    std::optional<Level> level;
+};
+
+DESCRIBE("Inner", Inner) {
+    MEMBER("ratio", &_::ratio);
+    MEMBER("level", &_::level);
+}
+
+struct Message {
+    int64_t id;
+    bool flag;
+    std::string text;
+    Inner inner;
+    std::optional<uint16_t> port;
+};
+
+DESCRIBE("Message", Message) {
+    MEMBER("id", &_::id);
+    MEMBER("flag", &_::flag);
+    MEMBER("text", &_::text);
+    MEMBER("inner", &_::inner);
+    MEMBER("port", &_::port);
+}
+
+constexpr std::string_view document = R"( {
+    "id": -42,
+    "unknown": {"a": [1, {"b": "}]"}, [], null], "c": 1e-5},
+    "text": "line\n\"quoted\" é 😀 {}",
+    "flag": true,
+    "inner": {"ratio": 0.25, "level": "high", "extra": false},
+    "port": null
+} trailing)";
+
+bool decode_in_chunks(size_t chunk) {
+    Message msg{};
+    msg.port = 80;
+    describe::incremental_decoder<Message> decoder(msg);
+    size_t offset = 0;
+    auto status = describe::decode_status::partial;
+    while (status == describe::decode_status::partial && offset < document.size()) {
+        status = decoder.feed(document.substr(offset, chunk));
+        offset += chunk;
+    }
+    return status == describe::decode_status::complete
+        && document.substr(decoder.consumed()) == " trailing"
+        && msg.id == -42
+        && msg.flag
+        && msg.text == "line\n\"quoted\" \xC3\xA9 \xF0\x9F\x98\x80 {}"
+        && msg.inner.ratio == 0.25
+        && msg.inner.level == Level::high
+        && !msg.port;
+}
+
+describe::decode_status decode(std::string_view json) {
+    Message msg{};
+    describe::incremental_decoder<Message> decoder(msg);
+    return decoder.feed(json);
+}
+
+} //incremental_test
+
+using namespace incremental_test;
+
+// fallback for standard libraries without floating-point std::from_chars()
+bool check_strtod_chars() {
+    auto parse = [](std::string_view text, double& out) {
+        auto res = describe::detail::strtod_chars(text.data(), text.data() + text.size(), out);
+        return res.ec == std::errc{} ? size_t(res.ptr - text.data()) : size_t(-1);
+    };
+    double value = 0;
+    const std::string digits(100, '1');
+    return parse("-0.25e2,", value) == 7 && value == -25
+        && parse("1-2", value) == 1 && value == 1
+        && parse("0x10", value) == 1 && value == 0
+        && parse(digits, value) == 100 && value > 1e99
+        && parse("+1", value) == size_t(-1)
+        && parse("inf", value) == size_t(-1)
+        && parse("1e999", value) == size_t(-1);
+}
+
+bool test_incremental() {
+    if (!check_strtod_chars()) return false;
+    for (size_t chunk = 1; chunk <= document.size(); ++chunk) {
+        if (!decode_in_chunks(chunk)) return false;
+    }
+    using describe::decode_status;
+    return decode(R"({"id": "str"})") == decode_status::error
+        && decode(R"({"inner": {"level": "medium"}})") == decode_status::error
+        && decode(R"({"id": 1.5})") == decode_status::error
+        && decode(R"({"id": null})") == decode_status::error
+        && decode(R"({"inner": null})") == decode_status::error
+        && decode(R"({"unknown": null, "port": null})") == decode_status::complete
+        // number syntax is checked for skipped values too
+        && decode(R"({"id": 01})") == decode_status::error
+        && decode(R"({"unknown": 01})") == decode_status::error
+        && decode(R"({"unknown": --1})") == decode_status::error
+        && decode(R"({"unknown": [1., 2]})") == decode_status::error
+        && decode(R"({"unknown": 1e})") == decode_status::error
+        && decode(R"({"unknown": [-0.5e+3, 0, 10E2]})") == decode_status::complete
+        && decode(R"({"id": 1,)") == decode_status::partial
+        && decode(R"({"id": 1]})") == decode_status::error
+        && decode(R"([])") == decode_status::error
+        && decode(R"({})") == decode_status::complete;
+}
@@ -0,0 +1,58 @@
+// Built as a separate executable with DESCRIBE_PROFILE defined
+#include <describe/describe.hpp>
+
+struct Counted {
+    int a;
+    int b;
+};
+
+DESCRIBE("Counted", Counted, describe::profiled) {
+    MEMBER("a", &_::a);
+    MEMBER("b", &_::b);
+}
+
+struct Partial {
+    int hot;
+    int cold;
+};
+
+DESCRIBE("Partial", Partial) {
+    MEMBER("hot", &_::hot, describe::profiled);
+    MEMBER("cold", &_::cold);
+}
+
+// still usable in constant expressions
+constexpr int sum(const Counted& c) {
+    int res = 0;
+    describe::Get<Counted>::for_each([&](auto f){
+        if constexpr (f.is_field) res += f.get(c);
+    });
+    return res;
+}
+
+static_assert(sum(Counted{1, 2}) == 3);
+
+int main() {
+    Counted c{1, 2};
+    const Counted& cref = c;
+    describe::Get<Counted>::for_each([&](auto f){
+        if constexpr (f.is_field) {
+            f.get(c) += f.get(cref);
+        }
+    });
+    describe::Member<&Counted::a>::get(cref);
+
+    auto report = describe::profile_report<Counted>();
+    if (report[0].name != "a" || report[0].const_accesses != 2 || report[0].mutable_accesses != 1) return 1;
+    if (report[1].name != "b" || report[1].const_accesses != 1 || report[1].mutable_accesses != 1) return 1;
+
+    Partial p{};
+    describe::Get<Partial>::for_each([&](auto f){
+        if constexpr (f.is_field) f.get(p)++;
+    });
+    auto partial = describe::profile_report<Partial>();
+    if (partial[0].mutable_accesses != 1 || partial[1].mutable_accesses != 0) return 1;
+
+    describe::profile_reset<Counted>();
+    return describe::profile_report<Counted>()[0].const_accesses != 0;
+}
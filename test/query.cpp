@@ -0,0 +1,104 @@
+#include <describe/query.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace query_test {
+
+enum class Kind {
+    good,
+    bad,
+    ugly,
+};
+
+DESCRIBE("Kind", Kind) {
+    MEMBER("good", _::good);
+    MEMBER("bad", _::bad);
+    MEMBER("ugly", _::ugly);
+    MEMBER("UGLY", _::ugly);
+}
+
+struct Person {
+    int age;
+    std::string name;
+    Kind type;
+    bool active;
+    double score;
+    std::optional<uint32_t> badge;
+};
+
+DESCRIBE("Person", Person) {
+    MEMBER("age", &_::age);
+    MEMBER("name", &_::name);
+    MEMBER("type", &_::type);
+    MEMBER("active", &_::active);
+    MEMBER("score", &_::score);
+    MEMBER("badge", &_::badge);
+}
+
+// tags can not be queried, but do not prevent query<Tagged>
+struct Tagged {
+    int age;
+    std::vector<int> tags;
+};
+
+DESCRIBE("Tagged", Tagged) {
+    MEMBER("age", &_::age);
+    MEMBER("tags", &_::tags);
+}
+
+bool same(std::vector<uint32_t> got, std::vector<uint32_t> expected) {
+    return got == expected;
+}
+
+} //query_test
+
+using namespace query_test;
+
+bool test_query() {
+    std::vector<Person> people;
+    for (int i = 0; i < 100; ++i) {
+        people.push_back({i, "p" + std::to_string(i), Kind(i % 3), i % 2 == 0, i * 0.5, std::nullopt});
+    }
+    people[70].badge = 7;
+    people[71].badge = 9;
+    people[5].type = Kind(5); // undescribed -> null
+    describe::columnar_writer<Person> columns;
+    columns.append(people);
+
+    auto check = [&](std::string_view expr, std::vector<uint32_t> expected) {
+        describe::query<Person> q;
+        if (!q.compile(expr)) return false;
+        std::vector<uint32_t> aos, soa;
+        q.select(people, aos);
+        q.select(columns, soa);
+        return same(aos, expected) && same(soa, expected);
+    };
+    if (!check("age > 95", {96, 97, 98, 99})) return false;
+    if (!check("age > 90 && type == \"ugly\"", {92, 95, 98})) return false;
+    if (!check("age >= 96 && (type == UGLY || !active)", {97, 98, 99})) return false;
+    if (!check("name == 'p42' || score <= 0.5", {0, 1, 42})) return false;
+    if (!check("badge > 7", {71})) return false;
+    if (!check("badge != 7 && age > 69 && age < 73", {71})) return false;
+    if (!check("!(age < 98) && active == true", {98})) return false;
+    if (!check("age < 7 && type != bad", {0, 2, 3, 6})) return false;
+    if (!check("age < 7 && !(type == bad)", {0, 2, 3, 5, 6})) return false;
+
+    std::vector<Tagged> tagged{{20, {}}, {40, {1, 2}}};
+    std::vector<uint32_t> older;
+    describe::query<Tagged> by_age("age > 30");
+    if (by_age.select(tagged, older) != 1 || older[0] != 1) return false;
+    describe::query<Tagged> by_tags;
+    if (by_tags.compile("tags == 1") || by_tags.error() != "unsupported field at position 4") return false;
+
+    describe::query<Person> q;
+    if (!q.compile("age > 30") || !q.matches(people[31]) || q.matches(people[30])) return false;
+    return !q.compile("height > 1")
+        && !q.compile("name")
+        && !q.compile("type == 'nice'")
+        && !q.compile("type < ugly")
+        && !q.compile("age > 'x'")
+        && !q.compile("age > 1 &&")
+        && !q.compile("(age > 1")
+        && q.error() == "expected ')' at position 8";
+}
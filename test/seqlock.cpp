@@ -0,0 +1,99 @@
+#include <describe/seqlock.hpp>
+#include <thread>
+#include <vector>
+
+namespace seqlock_test {
+
+enum class Mode {
+    idle,
+    busy,
+};
+
+DESCRIBE("Mode", Mode) {
+    MEMBER("idle", _::idle);
+    MEMBER("busy", _::busy);
+}
+
+struct Limits {
+    int64_t low;
+    int64_t high;
+};
+
+DESCRIBE("Limits", Limits) {
+    MEMBER("low", &_::low);
+    MEMBER("high", &_::high);
+}
+
+struct State {
+    uint64_t generation;
+    Mode mode;
+    char tag[13];
+    Limits limits;
+    double ratio;
+};
+
+DESCRIBE("State", State) {
+    MEMBER("generation", &_::generation);
+    MEMBER("mode", &_::mode);
+    MEMBER("tag", &_::tag);
+    MEMBER("limits", &_::limits);
+    MEMBER("ratio", &_::ratio);
+}
+
+static_assert(describe::detail::seq_field_index<State, &State::limits>() == 3);
+
+bool consistent(const State& s) {
+    const auto g = int64_t(s.generation);
+    return s.limits.low == -g && s.limits.high == g && s.ratio == double(g) / 2
+        && s.mode == (g % 2 ? Mode::busy : Mode::idle) && s.tag[12] == char(g % 100);
+}
+
+} //seqlock_test
+
+using namespace seqlock_test;
+
+bool test_seqlock() {
+    describe::seqlock<State> lock;
+    if (lock.version() != 1) return false;
+    State init = lock.snapshot();
+    if (init.generation != 0 || init.mode != Mode::idle || !consistent(init)) return false;
+
+    lock.update([](State& s){
+        s.generation = 5;
+        s.mode = Mode::busy;
+        s.tag[12] = 5;
+        s.limits = {-5, 5};
+        s.ratio = 2.5;
+    });
+    if (lock.version() != 2) return false;
+    if (lock.load<&State::generation>() != 5) return false;
+    if (lock.load<&State::limits>().high != 5) return false;
+    if (lock.writer_state().ratio != 2.5 || !consistent(lock.snapshot())) return false;
+
+    constexpr uint64_t rounds = 20000;
+    std::vector<std::thread> readers;
+    std::atomic<bool> failed{false};
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]{
+            uint64_t last = 0;
+            while (last < rounds) {
+                State s = lock.snapshot();
+                if (!consistent(s) || s.generation < last) failed = true;
+                auto limits = lock.load<&State::limits>();
+                if (limits.low != -limits.high) failed = true;
+                last = s.generation;
+            }
+        });
+    }
+    for (uint64_t g = 0; g <= rounds; ++g) {
+        lock.update([&](State& s){
+            s.generation = g;
+            s.mode = g % 2 ? Mode::busy : Mode::idle;
+            s.tag[12] = char(g % 100);
+            s.limits = {-int64_t(g), int64_t(g)};
+            s.ratio = double(g) / 2;
+        });
+    }
+    for (auto& t: readers) t.join();
+    return !failed && lock.snapshot().generation == rounds;
+}
@@ -0,0 +1,97 @@
+#include <describe/columnar.hpp>
+#include <describe/shape.hpp>
+#include <string>
+#include <vector>
+
+namespace shape_test {
+
+enum class Level : int8_t {
+    low = -1,
+    mid = 0,
+    high = 1,
+};
+
+DESCRIBE("Level", Level) {
+    MEMBER("low", _::low);
+    MEMBER("mid", _::mid);
+    MEMBER("high", _::high);
+}
+
+struct Base {
+    uint16_t id;
+};
+
+DESCRIBE("Base", Base) {
+    MEMBER("id", &_::id);
+}
+
+struct Row : Base {
+    int64_t delta;
+    float ratio;
+    double total;
+    bool active;
+    std::string label;
+    std::string_view tag;
+    Level level;
+};
+
+DESCRIBE("Row", Row) {
+    PARENT(Base);
+    MEMBER("delta", &_::delta);
+    MEMBER("ratio", &_::ratio);
+    MEMBER("total", &_::total);
+    MEMBER("active", &_::active);
+    MEMBER("label", &_::label);
+    MEMBER("tag", &_::tag);
+    MEMBER("level", &_::level);
+}
+
+struct Outer {
+    Row row;
+    uint8_t flag;
+};
+
+DESCRIBE("Outer", Outer) {
+    MEMBER("row", &_::row);
+    MEMBER("flag", &_::flag);
+}
+
+static_assert(describe::detail::shape_flat<Row>());
+static_assert(describe::detail::shape_erasable<Outer>() && !describe::detail::shape_flat<Outer>());
+static_assert(describe::detail::shape_enum_table<Level>::values[0] == uint64_t(-1));
+
+} //shape_test
+
+using namespace shape_test;
+
+bool test_shape() {
+    auto& outer = describe::shape_of<Outer>();
+    if (outer.name != "Outer" || outer.size != sizeof(Outer) || outer.fields.size() != 2) return false;
+    if (outer.fields[0].kind != describe::shape_kind::nested) return false;
+    auto& row = *outer.fields[0].nested;
+    if (&row != &describe::shape_of<Row>() || row.fields.size() != 8) return false;
+    if (row.fields[0].name != "id" || row.fields[0].offset != 0 || row.fields[0].size != 2) return false;
+    Outer probe{};
+    auto at = [&](const void* field) {
+        return size_t(static_cast<const char*>(field) - reinterpret_cast<const char*>(&probe));
+    };
+    if (row.fields[1].offset != at(&probe.row.delta) || row.fields[1].kind != describe::shape_kind::signed_int) return false;
+    if (outer.fields[1].offset != at(&probe.flag)) return false;
+
+    std::vector<Row> rows{
+        {{1}, -5, 0.25f, 1e300, true, "plain", "view", Level::low},
+        {{65535}, INT64_MIN, -1.5f, 0.1, false, "a,\"b\"", "", Level(7)},
+    };
+    std::string typed;
+    std::string erased;
+    describe::write_csv_typed<Row>(rows, typed);
+    describe::write_csv_erased<Row>(rows, erased);
+    // nested tables are rejected instead of written as empty cells
+    std::string nested;
+    Outer outers[1]{};
+    if (describe::write_csv_erased(outer, outers, 1, nested) || !nested.empty()) return false;
+    return typed == erased && erased ==
+        "id,delta,ratio,total,active,label,tag,level\n"
+        "1,-5,0.25,1e+300,true,plain,view,low\n"
+        "65535,-9223372036854775808,-1.5,0.1,false,\"a,\"\"b\"\"\",,7\n";
+}
@@ -0,0 +1,146 @@
+#include <describe/sort.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace sort_test {
+
+enum class Tier : int8_t {
+    low = -2,
+    mid = 0,
+    high = 3,
+};
+
+DESCRIBE("Tier", Tier) {
+    MEMBER("low", _::low);
+    MEMBER("mid", _::mid);
+    MEMBER("high", _::high);
+}
+
+struct Item {
+    std::string name;
+    double price;
+    int32_t stock;
+    Tier tier;
+    uint32_t id;
+};
+
+DESCRIBE("Item", Item) {
+    MEMBER("name", &_::name, describe::sort_key<2>);
+    MEMBER("price", &_::price, describe::sort_key<1>, describe::sort_descending);
+    MEMBER("stock", &_::stock);
+    MEMBER("tier", &_::tier, describe::sort_key<0>);
+    MEMBER("id", &_::id);
+}
+
+using plan = describe::detail::sort_plan<Item>;
+static_assert(plan::width == 1 + 8 + 8);
+static_assert(plan::keys[3].offset == 0 && plan::keys[1].offset == 1 && plan::keys[0].offset == 9);
+static_assert(!plan::keys[2].is_key && plan::keys[1].descending);
+
+struct Point {
+    int16_t x;
+    float y;
+};
+
+DESCRIBE("Point", Point) {
+    MEMBER("x", &_::x, describe::sort_key<>);
+    MEMBER("y", &_::y, describe::sort_key<>);
+}
+
+struct Pair {
+    int32_t a;
+    int32_t b;
+};
+
+// same pointer (and attributes) under two names
+DESCRIBE("Pair", Pair) {
+    MEMBER("a", &_::a, describe::sort_key<0>);
+    MEMBER("b", &_::b, describe::sort_key<1>);
+    MEMBER("a2", &_::a, describe::sort_key<0>);
+}
+
+// string key compared before another key
+struct Named {
+    std::string s;
+    int32_t x;
+};
+
+DESCRIBE("Named", Named) {
+    MEMBER("s", &_::s, describe::sort_key<0>);
+    MEMBER("x", &_::x, describe::sort_key<1>);
+}
+
+static_assert(describe::detail::sort_plan<Named>::exact_prefix() == 8);
+
+template<typename T>
+bool encoded_less(const T& a, const T& b) {
+    uint8_t ka[sizeof(T)], kb[sizeof(T)];
+    describe::detail::sort_encode(a, ka);
+    describe::detail::sort_encode(b, kb);
+    return memcmp(ka, kb, sizeof(T)) < 0;
+}
+
+bool check_encoding() {
+    const float floats[] = {-1e30f, -2.5f, -0.0f, 1e-40f, 1.0f, 3e38f};
+    for (size_t i = 1; i < std::size(floats); ++i) {
+        if (!encoded_less(floats[i - 1], floats[i])) return false;
+    }
+    return encoded_less<int64_t>(INT64_MIN, -1) && encoded_less<int64_t>(-1, 0)
+        && encoded_less<int8_t>(-128, 127) && encoded_less<uint16_t>(255, 256)
+        && !encoded_less(0.0, -0.0) && !encoded_less(-0.0, 0.0);
+}
+
+} //sort_test
+
+using namespace sort_test;
+
+bool test_sort() {
+    if (!check_encoding()) return false;
+
+    uint8_t key[12] = {};
+    describe::detail::sort_plan<Pair>::encode(Pair{-7, 1}, key);
+    if (memcmp(key, key + 4, 4) != 0 || key[11] != 1) return false;
+
+    std::vector<Item> items{
+        {"pear", 2.5, 1, Tier::mid, 0},
+        {"apple_green", 1.0, 2, Tier::high, 1},
+        {"apple_golden", 1.0, 3, Tier::high, 2},
+        {"plum", 4.0, 4, Tier::mid, 3},
+        {"apple_green", 1.0, 5, Tier::high, 4},
+        {"kiwi", -3.0, 6, Tier::low, 5},
+        {"fig", 2.5, 7, Tier::mid, 6},
+    };
+    std::vector<uint32_t> order;
+    describe::sorted_index<Item>(items, order);
+    const std::vector<uint32_t> expected{5, 3, 6, 0, 2, 1, 4};
+    if (order != expected) return false;
+
+    auto sorted = items;
+    describe::radix_sort<Item>(sorted);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (sorted[i].id != expected[i] || sorted[i].name != items[expected[i]].name) return false;
+    }
+
+    // same 8-byte prefix: the rest of the string decides before x
+    std::vector<Named> named{{"aaaaaaaaZ", 1}, {"aaaaaaaaA", 2}, {"aaaaaaaaA", 1}, {"b", 0}};
+    describe::radix_sort<Named>(named);
+    if (named[0].x != 1 || named[0].s != "aaaaaaaaA" || named[1].x != 2 || named[2].s != "aaaaaaaaZ") return false;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> coord(-300, 300);
+    std::vector<Point> points(5000);
+    for (auto& p: points) p = {int16_t(coord(gen)), float(coord(gen)) / 7};
+    auto reference = points;
+    std::stable_sort(reference.begin(), reference.end(), [](auto& a, auto& b){
+        return a.x != b.x ? a.x < b.x : a.y < b.y;
+    });
+    describe::radix_sort<Point>(points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].x != reference[i].x || points[i].y != reference[i].y) return false;
+    }
+    std::vector<Point> empty;
+    describe::radix_sort<Point>(empty);
+    return true;
+}
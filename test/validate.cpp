@@ -0,0 +1,79 @@
+#include <describe/validate.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace validate_test {
+
+enum class Grade {
+    a,
+    b,
+    c,
+    f,
+};
+
+inline bool not_empty(const std::string& str) {
+    return !str.empty();
+}
+
+inline bool not_c(Grade grade) {
+    return grade != Grade::c;
+}
+
+struct percent : describe::valid_range<0, 100> {};
+
+struct Row {
+    std::string name;
+    int8_t age;
+    uint32_t score;
+    double ratio;
+    Grade grade;
+};
+
+DESCRIBE("Row", Row) {
+    MEMBER("name", &_::name, describe::valid_if<not_empty>);
+    MEMBER("age", &_::age, describe::valid_range<0, 120>);
+    MEMBER("score", &_::score, percent);
+    MEMBER("ratio", &_::ratio, describe::valid_range<0, 1>);
+    MEMBER("grade", &_::grade, describe::valid_range<0, 2>, describe::valid_if<not_c>);
+}
+
+// empty optionals pass valid_range<>
+struct Patient {
+    std::optional<int> age;
+};
+
+DESCRIBE("Patient", Patient) {
+    MEMBER("age", &_::age, describe::valid_range<0, 150>);
+}
+
+static_assert(describe::detail::validated_fields<Row>().size() == 5);
+static_assert(describe::detail::cmp_less(-1, 0u));
+static_assert(!describe::detail::cmp_less(5u, -1));
+
+} //validate_test
+
+using namespace validate_test;
+
+bool test_validate() {
+    std::vector<Row> rows(130, Row{"ok", 30, 50, 0.5, Grade::b});
+    rows[3].age = -1;
+    rows[64].score = 101;
+    rows[64].grade = Grade::f;
+    rows[100].ratio = 0.0 / 0.0;
+    rows[100].grade = Grade::c; // in range, rejected by not_c()
+    rows[129].name = "";
+    std::vector<Patient> patients{{std::nullopt}, {30}, {200}};
+    auto checked = describe::validate_batch<Patient>(patients);
+    if (checked.errors.size() != 1 || checked.errors[0].row != 2) return false;
+
+    auto res = describe::validate_batch<Row>(rows);
+    if (res.rows != 130 || res.failed.size() != 3 || res.errors.size() != 4) return false;
+    if (!res.row_failed(3) || res.row_failed(4) || !res.row_failed(129)) return false;
+    auto& e = res.errors;
+    return e[0].row == 3 && e[0].fields == 0b00010
+        && e[1].row == 64 && e[1].fields == 0b10100
+        && e[2].row == 100 && e[2].fields == 0b11000
+        && e[3].row == 129 && e[3].fields == 0b00001
+        && describe::validate_batch<Row>(describe::span<const Row>{rows.data(), 3}).ok();
+}